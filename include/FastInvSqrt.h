@@ -0,0 +1,26 @@
+#ifndef FAST_INVSQRT_H_
+#define FAST_INVSQRT_H_
+
+#include <stdint.h>
+#include <string.h>
+
+// Bit trick inverse square root with 2 Newton steps, relative error < 5e-6.
+// Shared by FastMath.h and the I2Cdevlib quaternion helper, so it lives in
+// include/ where both src and lib see it. memcpy keeps it free of type
+// punning, compilers lower it to a register move.
+inline float fast_invsqrt(float x)
+{
+    float y;
+    uint32_t i;
+
+    memcpy(&i, &x, sizeof(i));
+    i = 0x5f3759df - (i >> 1);
+    memcpy(&y, &i, sizeof(y));
+
+    // newton steps
+    y = y * (1.5f - 0.5f * x * y * y);
+    y = y * (1.5f - 0.5f * x * y * y);
+    return y;
+}
+
+#endif /* FAST_INVSQRT_H_ */
@@ -47,6 +47,9 @@ THE SOFTWARE.
 */
 
 #include "I2Cdev.h"
+#ifdef I2CDEV_TRACE
+    #include "I2CdevTrace.h"
+#endif
 
 #if I2CDEV_IMPLEMENTATION == I2CDEV_ARDUINO_WIRE || I2CDEV_IMPLEMENTATION == I2CDEV_BUILTIN_SBWIRE
 
@@ -219,6 +222,9 @@ int8_t I2Cdev::readBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8
 
     int8_t count = 0;
     uint32_t t1 = millis();
+    #ifdef I2CDEV_TRACE
+        uint32_t traceStart = micros();
+    #endif
 
     #if (I2CDEV_IMPLEMENTATION == I2CDEV_ARDUINO_WIRE || I2CDEV_IMPLEMENTATION == I2CDEV_BUILTIN_SBWIRE || I2CDEV_IMPLEMENTATION == I2CDEV_TEENSY_3X_WIRE)
         TwoWire *useWire = &Wire;
@@ -316,6 +322,10 @@ int8_t I2Cdev::readBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8
         Serial.print(count, DEC);
         Serial.println(" read).");
     #endif
+    #ifdef I2CDEV_TRACE
+        I2CdevTrace::record(devAddr, regAddr, length, false, traceStart, micros() - traceStart,
+                            (length + I2CDEVLIB_WIRE_BUFFER_LENGTH - 1) / I2CDEVLIB_WIRE_BUFFER_LENGTH, count == length ? 0 : -1);
+    #endif
 
     return count;
 }
@@ -341,6 +351,9 @@ int8_t I2Cdev::readWords(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint1
 
     int8_t count = 0;
     uint32_t t1 = millis();
+    #ifdef I2CDEV_TRACE
+        uint32_t traceStart = micros();
+    #endif
 
 #if I2CDEV_IMPLEMENTATION == I2CDEV_ARDUINO_WIRE || I2CDEV_IMPLEMENTATION == I2CDEV_BUILTIN_SBWIRE || I2CDEV_IMPLEMENTATION == I2CDEV_TEENSY_3X_WIRE
         TwoWire *useWire = &Wire;
@@ -470,6 +483,10 @@ int8_t I2Cdev::readWords(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint1
         Serial.print(count, DEC);
         Serial.println(" read).");
     #endif
+    #ifdef I2CDEV_TRACE
+        I2CdevTrace::record(devAddr, regAddr, length * 2, false, traceStart, micros() - traceStart,
+                            (length * 2 + I2CDEVLIB_WIRE_BUFFER_LENGTH - 1) / I2CDEVLIB_WIRE_BUFFER_LENGTH, count == length ? 0 : -1);
+    #endif
     
     return count;
 }
@@ -598,6 +615,9 @@ bool I2Cdev::writeBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_
         Serial.print("...");
     #endif
     uint8_t status = 0;
+    #ifdef I2CDEV_TRACE
+        uint32_t traceStart = micros();
+    #endif
 
 #if I2CDEV_IMPLEMENTATION == I2CDEV_ARDUINO_WIRE || I2CDEV_IMPLEMENTATION == I2CDEV_BUILTIN_SBWIRE || I2CDEV_IMPLEMENTATION == I2CDEV_TEENSY_3X_WIRE
     TwoWire *useWire = &Wire;
@@ -644,6 +664,9 @@ bool I2Cdev::writeBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_
     #ifdef I2CDEV_SERIAL_DEBUG
         Serial.println(". Done.");
     #endif
+    #ifdef I2CDEV_TRACE
+        I2CdevTrace::record(devAddr, regAddr, length, true, traceStart, micros() - traceStart, 1, status);
+    #endif
     return status == 0;
 }
 
@@ -665,6 +688,9 @@ bool I2Cdev::writeWords(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint16
         Serial.print("...");
     #endif
     uint8_t status = 0;
+    #ifdef I2CDEV_TRACE
+        uint32_t traceStart = micros();
+    #endif
 
 #if I2CDEV_IMPLEMENTATION == I2CDEV_ARDUINO_WIRE || I2CDEV_IMPLEMENTATION == I2CDEV_BUILTIN_SBWIRE || I2CDEV_IMPLEMENTATION == I2CDEV_TEENSY_3X_WIRE
     TwoWire *useWire = &Wire;
@@ -715,6 +741,9 @@ bool I2Cdev::writeWords(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint16
     #ifdef I2CDEV_SERIAL_DEBUG
         Serial.println(". Done.");
     #endif
+    #ifdef I2CDEV_TRACE
+        I2CdevTrace::record(devAddr, regAddr, length * 2, true, traceStart, micros() - traceStart, 1, status);
+    #endif
     return status == 0;
 }
 
@@ -0,0 +1,119 @@
+// I2Cdev library collection - transaction recorder and per device bus stats
+
+#ifdef I2CDEV_TRACE
+#include "I2CdevTrace.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifdef ESP32
+    #include <freertos/FreeRTOS.h>
+    static portMUX_TYPE traceMux = portMUX_INITIALIZER_UNLOCKED;
+    #define TRACE_LOCK()    portENTER_CRITICAL(&traceMux)
+    #define TRACE_UNLOCK()  portEXIT_CRITICAL(&traceMux)
+#else
+    #define TRACE_LOCK()
+    #define TRACE_UNLOCK()
+#endif
+
+static i2cdev_trace_t traceRing[I2CDEV_TRACE_LEN];
+static uint32_t traceHead = 0;
+static i2cdev_stats_t traceStats[I2CDEV_TRACE_DEVS];
+static uint8_t traceDevs = 0;
+
+/** Record one finished transaction, called by I2Cdev.
+ * Devices past I2CDEV_TRACE_DEVS only show up in the ring.
+ */
+void I2CdevTrace::record(uint8_t dev, uint8_t reg, uint16_t len, bool write, uint32_t t_us, uint32_t dur_us, uint8_t chunks, int8_t status) {
+    i2cdev_trace_t *r;
+    i2cdev_stats_t *s = 0;
+    uint8_t bucket = 0;
+
+    while (bucket < I2CDEV_TRACE_BUCKETS - 1 && dur_us >= (2u << bucket)) bucket++;
+
+    TRACE_LOCK();
+    r = &traceRing[traceHead & (I2CDEV_TRACE_LEN - 1)];
+    traceHead++;
+    r->t_us = t_us;
+    r->dur_us = dur_us > 0xFFFF ? 0xFFFF : dur_us;
+    r->dev = dev;
+    r->reg = reg;
+    r->len = len;
+    r->write = write;
+    r->chunks = chunks;
+    r->status = status;
+
+    for (uint8_t k = 0; k < traceDevs; k++) {
+        if (traceStats[k].dev == dev) s = &traceStats[k];
+    }
+    if (!s && traceDevs < I2CDEV_TRACE_DEVS) {
+        s = &traceStats[traceDevs++];
+        memset(s, 0, sizeof(i2cdev_stats_t));
+        s->dev = dev;
+    }
+    if (s) {
+        s->xfers++;
+        s->bytes += len;
+        s->errors += status ? 1 : 0;
+        s->busy_us += dur_us;
+        s->hist[bucket]++;
+    }
+    TRACE_UNLOCK();
+}
+
+uint16_t I2CdevTrace::getRecords(i2cdev_trace_t *records, uint16_t count) {
+    uint32_t head;
+    uint16_t n;
+
+    TRACE_LOCK();
+    head = traceHead;
+    n = head < I2CDEV_TRACE_LEN ? head : I2CDEV_TRACE_LEN;
+    if (count > n) count = n;
+    for (uint16_t k = 0; k < count; k++) {
+        records[k] = traceRing[(head - count + k) & (I2CDEV_TRACE_LEN - 1)];
+    }
+    TRACE_UNLOCK();
+    return count;
+}
+
+const i2cdev_stats_t *I2CdevTrace::getStats(uint8_t dev) {
+    for (uint8_t k = 0; k < traceDevs; k++) {
+        if (traceStats[k].dev == dev) return &traceStats[k];
+    }
+    return 0;
+}
+
+const i2cdev_stats_t *I2CdevTrace::getStatsAt(uint8_t index) {
+    return index < traceDevs ? &traceStats[index] : 0;
+}
+
+void I2CdevTrace::reset() {
+    TRACE_LOCK();
+    traceHead = 0;
+    traceDevs = 0;
+    TRACE_UNLOCK();
+}
+
+uint16_t I2CdevTrace::toJSON(char *buf, uint16_t len) {
+    i2cdev_stats_t s;
+    uint32_t pos;
+
+    // snprintf returns the untruncated length, stop once the buffer is full
+    pos = snprintf(buf, len, "{");
+    for (uint8_t k = 0; k < traceDevs && pos < len; k++) {
+        TRACE_LOCK();
+        s = traceStats[k];
+        TRACE_UNLOCK();
+
+        pos += snprintf(buf + pos, len - pos, "%s\"0x%02X\":{\"n\":%lu,\"bytes\":%lu,\"err\":%lu,\"busy_us\":%lu,\"hist\":[",
+                        k ? "," : "", s.dev, (unsigned long)s.xfers, (unsigned long)s.bytes, (unsigned long)s.errors, (unsigned long)s.busy_us);
+        for (uint8_t b = 0; b < I2CDEV_TRACE_BUCKETS && pos < len; b++) {
+            pos += snprintf(buf + pos, len - pos, "%s%lu", b ? "," : "", (unsigned long)s.hist[b]);
+        }
+        if (pos < len) pos += snprintf(buf + pos, len - pos, "]}");
+    }
+    if (pos < len) pos += snprintf(buf + pos, len - pos, "}");
+
+    return pos < len ? pos : len - 1;
+}
+
+#endif /* I2CDEV_TRACE */
@@ -0,0 +1,48 @@
+// I2Cdev library collection - transaction recorder and per device bus stats
+// Only compiled in with -D I2CDEV_TRACE, see I2Cdev.cpp
+
+#ifndef _I2CDEV_TRACE_H_
+#define _I2CDEV_TRACE_H_
+
+#include <stdint.h>
+
+#define I2CDEV_TRACE_LEN        64      // last transactions kept, power of two
+#define I2CDEV_TRACE_DEVS       8       // distinct devices with stats
+#define I2CDEV_TRACE_BUCKETS    12      // latency [us]: <2, <4, ... <2048, more
+
+typedef struct {
+    uint32_t t_us;          // start, micros()
+    uint16_t dur_us;        // saturates at 65535
+    uint8_t dev;
+    uint8_t reg;
+    uint16_t len;           // bytes, readWords/writeWords count two per word
+    uint8_t write;
+    uint8_t chunks;         // Wire transactions it took (buffer splits)
+    int8_t status;          // 0 ok, Wire endTransmission code, -1 short read
+} i2cdev_trace_t;
+
+typedef struct {
+    uint8_t dev;
+    uint32_t xfers;
+    uint32_t bytes;
+    uint32_t errors;
+    uint32_t busy_us;       // wraps after ~71 min of bus time
+    uint32_t hist[I2CDEV_TRACE_BUCKETS];
+} i2cdev_stats_t;
+
+class I2CdevTrace {
+    public:
+        static void record(uint8_t dev, uint8_t reg, uint16_t len, bool write, uint32_t t_us, uint32_t dur_us, uint8_t chunks, int8_t status);
+
+        // copies the newest count records (oldest first), returns copied
+        static uint16_t getRecords(i2cdev_trace_t *records, uint16_t count);
+        // null for a device never seen
+        static const i2cdev_stats_t *getStats(uint8_t dev);
+        static const i2cdev_stats_t *getStatsAt(uint8_t index);
+        static void reset();
+
+        // {"0x68":{"n":..,"bytes":..,"err":..,"busy_us":..,"hist":[..]},...}
+        static uint16_t toJSON(char *buf, uint16_t len);
+};
+
+#endif /* _I2CDEV_TRACE_H_ */
@@ -435,7 +435,17 @@ THE SOFTWARE.
 #define MPU6050_DMP_MEMORY_BANK_SIZE    256
 #define MPU6050_DMP_MEMORY_CHUNK_SIZE   16
 
+// MEM_R_W burst, one Wire transaction including the register byte
+#ifndef MPU6050_DMP_MEMORY_BURST_SIZE
+#define MPU6050_DMP_MEMORY_BURST_SIZE   (I2CDEVLIB_WIRE_BUFFER_LENGTH - 1)
+#endif
+#define MPU6050_RESET_TIMEOUT_MS        100
+
 #define MPU6050_FIFO_DEFAULT_TIMEOUT 11000
+#define MPU6050_FIFO_SIZE           1024
+
+// write-through shadow of the configuration registers 0x00..PWR_MGMT_2
+#define MPU6050_SHADOW_LEN          (MPU6050_RA_PWR_MGMT_2 + 1)
 
 class MPU6050_Base {
     public:
@@ -719,6 +729,7 @@ class MPU6050_Base {
         // FIFO_R_W register
         uint8_t getFIFOByte();
 		int8_t GetCurrentFIFOPacket(uint8_t *data, uint8_t length);
+        uint16_t GetFIFOPackets(uint8_t *data, uint8_t length, uint16_t maxPackets, bool *resynced=0);
         void setFIFOByte(uint8_t data);
         void getFIFOBytes(uint8_t *data, uint8_t length);
         void setFIFOTimeout(uint32_t fifoTimeout);
@@ -808,6 +819,7 @@ class MPU6050_Base {
         
         // MEM_START_ADDR register
         void setMemoryStartAddress(uint8_t address);
+        bool setMemoryPointer(uint8_t bank, uint8_t address);
         
         // MEM_R_W register
         uint8_t readMemoryByte();
@@ -834,11 +846,21 @@ class MPU6050_Base {
 		void PrintActiveOffsets(); // See the results of the Calibration
 		int16_t * GetActiveOffsets();
 
+        // register shadow, call after writing the chip behind this object's back
+        void invalidateShadow();
+
     protected:
         uint8_t devAddr;
         void *wireObj;
         uint8_t buffer[14];
         uint32_t fifoTimeout = MPU6050_FIFO_DEFAULT_TIMEOUT;
+
+        uint8_t shadow[MPU6050_SHADOW_LEN];
+        uint8_t shadowValid[(MPU6050_SHADOW_LEN + 7) / 8];
+        bool writeReg(uint8_t regAddr, uint8_t data);
+        bool waitRegClear(uint8_t regAddr, uint8_t mask, uint16_t timeout_ms);
+        bool writeRegBit(uint8_t regAddr, uint8_t bitNum, uint8_t data);
+        bool writeRegBits(uint8_t regAddr, uint8_t bitStart, uint8_t length, uint8_t data);
     
     private:
         int16_t offsets[6];
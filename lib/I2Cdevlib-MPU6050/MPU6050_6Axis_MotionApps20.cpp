@@ -614,3 +614,7 @@ uint16_t MPU6050_6Axis_MotionApps20::dmpGetFIFOPacketSize() {
 uint8_t MPU6050_6Axis_MotionApps20::dmpGetCurrentFIFOPacket(uint8_t *data) { // overflow proof
     return(GetCurrentFIFOPacket(data, dmpPacketSize));
 }
+
+uint16_t MPU6050_6Axis_MotionApps20::dmpGetFIFOPackets(uint8_t *data, uint16_t maxPackets) { // lossless
+    return(GetFIFOPackets(data, dmpPacketSize, maxPackets));
+}
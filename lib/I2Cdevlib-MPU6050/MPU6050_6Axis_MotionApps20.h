@@ -142,6 +142,7 @@ class MPU6050_6Axis_MotionApps20 : public MPU6050_Base {
         void dmpOverrideQuaternion(long *q);
         uint16_t dmpGetFIFOPacketSize();
         uint8_t dmpGetCurrentFIFOPacket(uint8_t *data); // overflow proof
+        uint16_t dmpGetFIFOPackets(uint8_t *data, uint16_t maxPackets); // lossless
 
     private:
         uint8_t *dmpPacketBuffer;
@@ -142,10 +142,13 @@ class MPU6050_6Axis_MotionApps612 : public MPU6050_Base {
         void dmpOverrideQuaternion(long *q);
         uint16_t dmpGetFIFOPacketSize();
         uint8_t dmpGetCurrentFIFOPacket(uint8_t *data); // overflow proof
+        uint16_t dmpGetFIFOPackets(uint8_t *data, uint16_t maxPackets); // lossless
+        uint32_t dmpGetLoadTime(); // [us]
 
     private:
         uint8_t *dmpPacketBuffer;
         uint16_t dmpPacketSize;
+        uint32_t dmpLoadTime = 0;
 };
 
 typedef MPU6050_6Axis_MotionApps612 MPU6050;
@@ -32,6 +32,10 @@ THE SOFTWARE.
 #ifndef _HELPER_3DMATH_H_
 #define _HELPER_3DMATH_H_
 
+#ifdef USE_FASTMATH
+#include "FastInvSqrt.h"
+#endif
+
 class Quaternion {
     public:
         float w;
@@ -75,11 +79,19 @@ class Quaternion {
         }
         
         void normalize() {
+#ifdef USE_FASTMATH
+            float m = fast_invsqrt(w*w + x*x + y*y + z*z);
+            w *= m;
+            x *= m;
+            y *= m;
+            z *= m;
+#else
             float m = getMagnitude();
             w /= m;
             x /= m;
             y /= m;
             z /= m;
+#endif
         }
         
         Quaternion getNormalized() {
@@ -0,0 +1,22 @@
+#ifndef I2C_BUS_H_
+#define I2C_BUS_H_
+
+#include <stdint.h>
+
+// Register level I2C access, lets the sensor drivers run against a mock
+class I2CBus {
+public:
+    virtual ~I2CBus() {};
+
+    // burst over auto incremented registers, false on bus error / nack
+    virtual bool read(uint8_t dev, uint8_t reg, uint8_t len, uint8_t* p_data) = 0;
+    virtual bool write(uint8_t dev, uint8_t reg, uint8_t len, 
+                       const uint8_t* p_data) = 0;
+
+    bool writeByte(uint8_t dev, uint8_t reg, uint8_t data)
+    {
+        return write(dev, reg, 1, &data);
+    }
+};
+
+#endif /* I2C_BUS_H_ */
@@ -0,0 +1,102 @@
+#include "I2CBusMock.h"
+#include <string.h>
+
+/* private macros ------------------------------------------------------------*/
+#define MOCK_REGS   256
+
+I2CBusMock::I2CBusMock()
+{
+}
+
+I2CBusMock::~I2CBusMock()
+{
+}
+
+void I2CBusMock::attach(uint8_t dev)
+{
+    mRegs[dev].assign(MOCK_REGS, 0);
+}
+
+void I2CBusMock::setReg(uint8_t dev, uint8_t reg, uint8_t data)
+{
+    mRegs.at(dev)[reg] = data;
+}
+
+uint8_t I2CBusMock::getReg(uint8_t dev, uint8_t reg)
+{
+    return mRegs.at(dev)[reg];
+}
+
+void I2CBusMock::pushStream(uint8_t dev, uint8_t reg, const uint8_t* p_data, 
+                            uint32_t len)
+{
+    std::deque<uint8_t>& stream = mStream[(dev << 8) | reg];
+
+    stream.insert(stream.end(), p_data, p_data + len);
+}
+
+bool I2CBusMock::read(uint8_t dev, uint8_t reg, uint8_t len, uint8_t* p_data)
+{
+    if (0 == mRegs.count(dev))
+    {
+        record(dev, reg, len, false, nullptr);
+        return false;
+    }
+
+    if (0 != mStream.count((dev << 8) | reg))
+    {
+        std::deque<uint8_t>& stream = mStream[(dev << 8) | reg];
+
+        for (uint8_t u8_k = 0; u8_k < len; u8_k++)
+        {
+            p_data[u8_k] = stream.empty() ? 0 : stream.front();
+            if (!stream.empty())
+            {
+                stream.pop_front();
+            }
+        }
+        record(dev, reg, len, false, p_data);
+        return true;
+    }
+
+    // address wraps like the register pointer does
+    for (uint8_t u8_k = 0; u8_k < len; u8_k++)
+    {
+        p_data[u8_k] = mRegs[dev][(uint8_t)(reg + u8_k)];
+    }
+    record(dev, reg, len, false, p_data);
+    return true;
+}
+
+bool I2CBusMock::write(uint8_t dev, uint8_t reg, uint8_t len, 
+                       const uint8_t* p_data)
+{
+    record(dev, reg, len, true, p_data);
+    if (0 == mRegs.count(dev))
+    {
+        return false;
+    }
+
+    for (uint8_t u8_k = 0; u8_k < len; u8_k++)
+    {
+        mRegs[dev][(uint8_t)(reg + u8_k)] = p_data[u8_k];
+    }
+    return true;
+}
+
+void I2CBusMock::record(uint8_t dev, uint8_t reg, uint8_t len, bool write, 
+                        const uint8_t* p_data)
+{
+    sI2CXfer_t xfer;
+
+    memset(&xfer, 0x0, sizeof(sI2CXfer_t));
+    xfer.dev = dev;
+    xfer.reg = reg;
+    xfer.len = len;
+    xfer.write = write;
+    if (nullptr != p_data)
+    {
+        memcpy(xfer.data, p_data, (len < sizeof(xfer.data)) ? len : sizeof(xfer.data));
+    }
+    mLog.push_back(xfer);
+}
@@ -0,0 +1,59 @@
+#ifndef I2C_BUS_MOCK_H_
+#define I2C_BUS_MOCK_H_
+
+#include "I2CBus.h"
+#include <map>
+#include <deque>
+#include <vector>
+
+typedef struct
+{
+    uint8_t dev;
+    uint8_t reg;
+    uint8_t len;
+    bool write;
+    uint8_t data[32];       // first bytes written / returned
+} sI2CXfer_t;
+
+// Host register file per attached device, records every transaction so 
+// tests can check the sequence a driver issues
+class I2CBusMock : public I2CBus {
+public:
+    I2CBusMock();
+    ~I2CBusMock();
+
+    bool read(uint8_t dev, uint8_t reg, uint8_t len, uint8_t* p_data) override;
+    bool write(uint8_t dev, uint8_t reg, uint8_t len, 
+               const uint8_t* p_data) override;
+
+    // unattached devices nack
+    void attach(uint8_t dev);
+
+    void setReg(uint8_t dev, uint8_t reg, uint8_t data);
+    uint8_t getReg(uint8_t dev, uint8_t reg);
+
+    // reads starting at a stream register (e.g. FIFO_R_W) pop queued bytes 
+    // instead of walking the register file, empty queue reads 0
+    void pushStream(uint8_t dev, uint8_t reg, const uint8_t* p_data, 
+                    uint32_t len);
+
+    const std::vector<sI2CXfer_t>& getLog() const
+    {
+        return mLog;
+    }
+
+    void clearLog()
+    {
+        mLog.clear();
+    }
+
+private:
+    std::map<uint8_t, std::vector<uint8_t>> mRegs;
+    std::vector<sI2CXfer_t> mLog;
+    std::map<uint16_t, std::deque<uint8_t>> mStream;
+
+    void record(uint8_t dev, uint8_t reg, uint8_t len, bool write, 
+                const uint8_t* p_data);
+};
+
+#endif /* I2C_BUS_MOCK_H_ */
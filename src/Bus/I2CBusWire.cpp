@@ -0,0 +1,23 @@
+#ifdef ARDUINO
+#include "I2CBusWire.h"
+#include <I2Cdev.h>
+
+I2CBusWire::I2CBusWire()
+{
+}
+
+I2CBusWire::~I2CBusWire()
+{
+}
+
+bool I2CBusWire::read(uint8_t dev, uint8_t reg, uint8_t len, uint8_t* p_data)
+{
+    return (len == I2Cdev::readBytes(dev, reg, len, p_data));
+}
+
+bool I2CBusWire::write(uint8_t dev, uint8_t reg, uint8_t len, 
+                       const uint8_t* p_data)
+{
+    return I2Cdev::writeBytes(dev, reg, len, (uint8_t*)p_data);
+}
+#endif
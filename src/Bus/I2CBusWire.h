@@ -0,0 +1,17 @@
+#ifndef I2C_BUS_WIRE_H_
+#define I2C_BUS_WIRE_H_
+
+#include "I2CBus.h"
+
+// I2Cdev (Wire) backed bus, same transactions the I2Cdevlib drivers issue
+class I2CBusWire : public I2CBus {
+public:
+    I2CBusWire();
+    ~I2CBusWire();
+
+    bool read(uint8_t dev, uint8_t reg, uint8_t len, uint8_t* p_data) override;
+    bool write(uint8_t dev, uint8_t reg, uint8_t len, 
+               const uint8_t* p_data) override;
+};
+
+#endif /* I2C_BUS_WIRE_H_ */
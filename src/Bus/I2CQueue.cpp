@@ -0,0 +1,180 @@
+#include "I2CQueue.h"
+#ifdef ARDUINO
+#include <esp_pthread.h>
+#endif
+
+/* private macros ------------------------------------------------------------*/
+// bus worker sits with the sensor task, above it so transfers start at once
+#define I2C_WORKER_CORE     1
+#define I2C_WORKER_PRIO     6
+#define I2C_WORKER_STACK    4096
+
+/* private typedef -----------------------------------------------------------*/
+typedef struct
+{
+    I2CQueue* p_queue;
+    bool done;
+    bool ok;
+} sI2CSync_t;
+
+I2CQueue::I2CQueue(I2CBus& backend)
+    : mBackend{backend}
+    , mRun{false}
+    , mHead{0}
+    , mTail{0}
+    , mHighWater{0}
+{
+}
+
+I2CQueue::~I2CQueue()
+{
+    end();
+}
+
+void I2CQueue::begin()
+{
+#ifdef ARDUINO
+    esp_pthread_cfg_t cfg = esp_pthread_get_default_config();
+
+    cfg.pin_to_core = I2C_WORKER_CORE;
+    cfg.prio = I2C_WORKER_PRIO;
+    cfg.stack_size = I2C_WORKER_STACK;
+    cfg.thread_name = "i2c";
+    esp_pthread_set_cfg(&cfg);
+#endif
+
+    mRun = true;
+    mWorker = std::thread(&I2CQueue::run, this);
+}
+
+void I2CQueue::end()
+{
+    {
+        std::lock_guard<std::mutex> guard(mLock);
+        mRun = false;
+    }
+    mWork.notify_one();
+
+    if (mWorker.joinable())
+    {
+        mWorker.join();
+    }
+}
+
+bool I2CQueue::submit(const sI2CXact_t* p_xact)
+{
+    {
+        std::lock_guard<std::mutex> guard(mLock);
+
+        if (!push(p_xact))
+        {
+            return false;
+        }
+    }
+    mWork.notify_one();
+    return true;
+}
+
+bool I2CQueue::push(const sI2CXact_t* p_xact)
+{
+    if (!mRun || (I2C_QUEUE_LEN == (mHead - mTail)))
+    {
+        return false;
+    }
+
+    mQueue[mHead % I2C_QUEUE_LEN] = *p_xact;
+    mHead++;
+    if ((mHead - mTail) > mHighWater)
+    {
+        mHighWater = mHead - mTail;
+    }
+    return true;
+}
+
+void I2CQueue::run()
+{
+    sI2CXact_t xact;
+    bool ok;
+
+    while (1)
+    {
+        {
+            std::unique_lock<std::mutex> guard(mLock);
+
+            mWork.wait(guard, [this] { return !mRun || (mHead != mTail); });
+
+            // drain what was queued before stopping
+            if (mHead == mTail)
+            {
+                return;
+            }
+            xact = mQueue[mTail % I2C_QUEUE_LEN];
+            mTail++;
+        }
+        mDone.notify_all();
+
+        // bus time runs without the lock, submitters keep going
+        if (xact.write)
+        {
+            ok = mBackend.write(xact.dev, xact.reg, xact.len, xact.p_data);
+        }
+        else
+        {
+            ok = mBackend.read(xact.dev, xact.reg, xact.len, xact.p_data);
+        }
+
+        if (nullptr != xact.done)
+        {
+            xact.done(xact.p_arg, ok);
+        }
+    }
+}
+
+bool I2CQueue::read(uint8_t dev, uint8_t reg, uint8_t len, uint8_t* p_data)
+{
+    return transfer(dev, reg, len, false, p_data);
+}
+
+bool I2CQueue::write(uint8_t dev, uint8_t reg, uint8_t len, 
+                     const uint8_t* p_data)
+{
+    return transfer(dev, reg, len, true, (uint8_t*)p_data);
+}
+
+bool I2CQueue::transfer(uint8_t dev, uint8_t reg, uint8_t len, bool write, 
+                        uint8_t* p_data)
+{
+    sI2CSync_t sync = { this, false, false };
+    sI2CXact_t xact = { dev, reg, len, write, p_data, wake, &sync };
+    std::unique_lock<std::mutex> guard(mLock);
+
+    // wait for a free slot, then for our own completion
+    while (!push(&xact))
+    {
+        if (!mRun)
+        {
+            return false;
+        }
+        mDone.wait(guard);
+    }
+    guard.unlock();
+    mWork.notify_one();
+
+    guard.lock();
+    mDone.wait(guard, [&sync] { return sync.done; });
+    return sync.ok;
+}
+
+void I2CQueue::wake(void* p_arg, bool ok)
+{
+    sI2CSync_t* p_sync = (sI2CSync_t*)p_arg;
+    I2CQueue* p_queue = p_sync->p_queue;
+
+    // p_sync lives on the waiter stack, gone as soon as it sees done
+    {
+        std::lock_guard<std::mutex> guard(p_queue->mLock);
+        p_sync->ok = ok;
+        p_sync->done = true;
+    }
+    p_queue->mDone.notify_all();
+}
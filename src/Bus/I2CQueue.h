@@ -0,0 +1,73 @@
+#ifndef I2C_QUEUE_H_
+#define I2C_QUEUE_H_
+
+#include "I2CBus.h"
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
+#define I2C_QUEUE_LEN   16
+
+// runs on the bus worker once the transfer is over
+typedef void (*I2CDone_t)(void* p_arg, bool ok);
+
+typedef struct
+{
+    uint8_t dev;
+    uint8_t reg;
+    uint8_t len;
+    bool write;
+    uint8_t* p_data;        // caller owned until done
+    I2CDone_t done;         // may be null
+    void* p_arg;
+} sI2CXact_t;
+
+// Transactions queued to a bus worker thread which runs them in order on 
+// the backend (I2CBusWire on target, I2CBusMock on host). Any task may 
+// submit and go on, completion is reported through the callback. The 
+// I2CBus interface on top blocks until its own transfer is done, so the 
+// existing drivers can share the worker; never call it from a callback.
+class I2CQueue : public I2CBus {
+public:
+    I2CQueue(I2CBus& backend);
+    ~I2CQueue();
+
+    void begin();
+    void end();
+
+    // false when the queue is full or stopped
+    bool submit(const sI2CXact_t* p_xact);
+
+    bool read(uint8_t dev, uint8_t reg, uint8_t len, uint8_t* p_data) override;
+    bool write(uint8_t dev, uint8_t reg, uint8_t len, 
+               const uint8_t* p_data) override;
+
+    // deepest the queue got, to size I2C_QUEUE_LEN
+    uint32_t getHighWater() const
+    {
+        return mHighWater;
+    }
+
+private:
+    I2CBus& mBackend;
+
+    std::mutex mLock;
+    std::condition_variable mWork;
+    std::condition_variable mDone;
+    std::thread mWorker;
+    bool mRun;
+
+    sI2CXact_t mQueue[I2C_QUEUE_LEN];
+    uint32_t mHead;
+    uint32_t mTail;
+    uint32_t mHighWater;
+
+    void run();
+    bool push(const sI2CXact_t* p_xact);
+    bool transfer(uint8_t dev, uint8_t reg, uint8_t len, bool write, 
+                  uint8_t* p_data);
+
+    static void wake(void* p_arg, bool ok);
+};
+
+#endif /* I2C_QUEUE_H_ */
@@ -0,0 +1,37 @@
+#ifndef CALIB_BLOB_H_
+#define CALIB_BLOB_H_
+
+#include <stdint.h>
+
+/* exported macros  ----------------------------------------------------------*/
+#define CALIB_MAGIC     0x424C4143      // "CALB"
+#define CALIB_VERSION   2
+
+#define CALIB_IMU       (1 << 0)        // SensorFUSE biases
+#define CALIB_MAGN      (1 << 1)        // SensorMagnet ranges
+#define CALIB_DMP       (1 << 2)        // MPU6050 offset registers
+#define CALIB_LUT       (1 << 3)        // SensorFUSE temperature bias table
+
+#define CALIB_LUT_BINS  12
+
+/* exported typedef ----------------------------------------------------------*/
+typedef struct
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t flags;
+
+    float biasGyro[3];
+    float biasAccl[3];
+    float rangeMagn[3][2];
+    int16_t offsAccl[3];
+    int16_t offsGyro[3];
+    float lutGyro[CALIB_LUT_BINS][3];
+    float lutAccl[CALIB_LUT_BINS][3];
+    uint16_t lutGyroMask;               // bit n set for a learned bin n
+    uint16_t lutAcclMask;
+
+    uint32_t crc;
+} sCalibBlob_t;
+
+#endif /* CALIB_BLOB_H_ */
@@ -0,0 +1,15 @@
+#ifndef CALIB_STORAGE_H_
+#define CALIB_STORAGE_H_
+
+#include <stddef.h>
+
+// Where the calibration blob lives, backends only move raw bytes
+class CalibStorage {
+public:
+    virtual ~CalibStorage() {};
+
+    virtual bool read(void* p_data, size_t size) = 0;
+    virtual bool write(const void* p_data, size_t size) = 0;
+};
+
+#endif /* CALIB_STORAGE_H_ */
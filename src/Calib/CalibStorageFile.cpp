@@ -0,0 +1,45 @@
+#include "CalibStorageFile.h"
+#include <cstdio>
+
+CalibStorageFile::CalibStorageFile(const char* path)
+    : mPath{path}
+{
+}
+
+CalibStorageFile::~CalibStorageFile()
+{
+}
+
+bool CalibStorageFile::read(void* p_data, size_t size)
+{
+    FILE* file;
+    size_t n;
+
+    file = fopen(mPath, "rb");
+    if (nullptr == file)
+    {
+        return false;
+    }
+
+    n = fread(p_data, 1, size, file);
+    fclose(file);
+
+    return (n == size);
+}
+
+bool CalibStorageFile::write(const void* p_data, size_t size)
+{
+    FILE* file;
+    size_t n;
+
+    file = fopen(mPath, "wb");
+    if (nullptr == file)
+    {
+        return false;
+    }
+
+    n = fwrite(p_data, 1, size, file);
+    fclose(file);
+
+    return (n == size);
+}
@@ -0,0 +1,19 @@
+#ifndef CALIB_STORAGE_FILE_H_
+#define CALIB_STORAGE_FILE_H_
+
+#include "CalibStorage.h"
+
+// stdio backed, a host path on Linux or a VFS path (/spiffs/...) on ESP32
+class CalibStorageFile : public CalibStorage {
+public:
+    CalibStorageFile(const char* path);
+    ~CalibStorageFile();
+
+    bool read(void* p_data, size_t size) override;
+    bool write(const void* p_data, size_t size) override;
+
+private:
+    const char* mPath;
+};
+
+#endif /* CALIB_STORAGE_FILE_H_ */
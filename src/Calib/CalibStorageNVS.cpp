@@ -0,0 +1,43 @@
+#ifdef ARDUINO
+#include "CalibStorageNVS.h"
+#include <Preferences.h>
+
+CalibStorageNVS::CalibStorageNVS(const char* name)
+    : mName{name}
+{
+}
+
+CalibStorageNVS::~CalibStorageNVS()
+{
+}
+
+bool CalibStorageNVS::read(void* p_data, size_t size)
+{
+    Preferences prefs;
+    size_t n;
+
+    if (!prefs.begin(mName, true))
+    {
+        return false;
+    }
+    n = prefs.getBytes("blob", p_data, size);
+    prefs.end();
+
+    return (n == size);
+}
+
+bool CalibStorageNVS::write(const void* p_data, size_t size)
+{
+    Preferences prefs;
+    size_t n;
+
+    if (!prefs.begin(mName, false))
+    {
+        return false;
+    }
+    n = prefs.putBytes("blob", p_data, size);
+    prefs.end();
+
+    return (n == size);
+}
+#endif
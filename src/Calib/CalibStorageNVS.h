@@ -0,0 +1,19 @@
+#ifndef CALIB_STORAGE_NVS_H_
+#define CALIB_STORAGE_NVS_H_
+
+#include "CalibStorage.h"
+
+// ESP32 non volatile storage, one key inside the given namespace
+class CalibStorageNVS : public CalibStorage {
+public:
+    CalibStorageNVS(const char* name);
+    ~CalibStorageNVS();
+
+    bool read(void* p_data, size_t size) override;
+    bool write(const void* p_data, size_t size) override;
+
+private:
+    const char* mName;
+};
+
+#endif /* CALIB_STORAGE_NVS_H_ */
@@ -0,0 +1,61 @@
+#include "CalibStore.h"
+#include <cstddef>
+#include <cstring>
+
+CalibStore::CalibStore(CalibStorage& storage)
+    : mStorage{storage}
+{
+    memset(&mBlob, 0x0, sizeof(sCalibBlob_t));
+}
+
+CalibStore::~CalibStore()
+{
+}
+
+bool CalibStore::load()
+{
+    sCalibBlob_t blob;
+
+    if (!mStorage.read(&blob, sizeof(sCalibBlob_t)))
+    {
+        return false;
+    }
+
+    // reject other layouts and torn writes
+    if ((CALIB_MAGIC != blob.magic) || (CALIB_VERSION != blob.version) || 
+        (crc32(&blob, offsetof(sCalibBlob_t, crc)) != blob.crc))
+    {
+        return false;
+    }
+
+    memcpy(&mBlob, &blob, sizeof(sCalibBlob_t));
+    return true;
+}
+
+bool CalibStore::save()
+{
+    mBlob.magic   = CALIB_MAGIC;
+    mBlob.version = CALIB_VERSION;
+    mBlob.crc     = crc32(&mBlob, offsetof(sCalibBlob_t, crc));
+
+    return mStorage.write(&mBlob, sizeof(sCalibBlob_t));
+}
+
+uint32_t CalibStore::crc32(const void* p_data, size_t size)
+{
+    const uint8_t* p_byte = (const uint8_t*) p_data;
+    uint32_t crc;
+
+    // bitwise CRC-32 (IEEE), blob is small and only hashed at boot
+    crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < size; i++)
+    {
+        crc ^= p_byte[i];
+        for (uint8_t u8_b = 0; u8_b < 8; u8_b++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+
+    return ~crc;
+}
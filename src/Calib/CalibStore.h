@@ -0,0 +1,27 @@
+#ifndef CALIB_STORE_H_
+#define CALIB_STORE_H_
+
+#include "CalibBlob.h"
+#include "CalibStorage.h"
+
+class CalibStore {
+public:
+    CalibStore(CalibStorage& storage);
+    ~CalibStore();
+
+    bool load();
+    bool save();
+
+    sCalibBlob_t* getBlob()
+    {
+        return &mBlob;
+    }
+
+private:
+    CalibStorage& mStorage;
+    sCalibBlob_t mBlob;
+
+    uint32_t crc32(const void* p_data, size_t size);
+};
+
+#endif /* CALIB_STORE_H_ */
@@ -0,0 +1,129 @@
+#ifndef FAST_MATH_H_
+#define FAST_MATH_H_
+
+#include <stdint.h>
+#include <cmath>
+
+#include "FastInvSqrt.h"
+
+// Polynomial approximations for the per sample path. Bounds below are the
+// worst case over the whole input range measured against libm on float:
+//   fast_invsqrt  relative error < 5e-6   (bit trick + 2 Newton steps)
+//   fast_sqrt     relative error < 5e-6
+//   fast_atan2    absolute error < 1.2e-5 rad (A&S 4.4.49 on first octant)
+//   fast_asin     absolute error < 7.5e-5 rad (A&S 4.4.45)
+
+inline float fast_sqrt(float x)
+{
+    if (0.0f >= x)
+    {
+        return 0.0f;
+    }
+    return x * fast_invsqrt(x);
+}
+
+inline float fast_atan2(float y, float x)
+{
+    float ax, ay, z, z2, a;
+
+    ax = fabsf(x);
+    ay = fabsf(y);
+    if ((0.0f == ax) && (0.0f == ay))
+    {
+        return 0.0f;
+    }
+
+    // reduce to first octant
+    z  = (ax >= ay) ? (ay / ax) : (ax / ay);
+    z2 = z * z;
+    a  = z * (0.9998660f + z2 * (-0.3302995f + z2 * (0.1801410f + 
+              z2 * (-0.0851330f + z2 * 0.0208351f))));
+
+    if (ay > ax)
+    {
+        a = (float)M_PI_2 - a;
+    }
+    if (0.0f > x)
+    {
+        a = (float)M_PI - a;
+    }
+    if (0.0f > y)
+    {
+        a = -a;
+    }
+
+    return a;
+}
+
+inline float fast_asin(float x)
+{
+    float ax, a;
+
+    ax = fabsf(x);
+    if (1.0f <= ax)
+    {
+        return (0.0f > x) ? -(float)M_PI_2 : (float)M_PI_2;
+    }
+
+    a = (float)M_PI_2 - fast_sqrt(1.0f - ax) * 
+        (1.5707288f + ax * (-0.2121144f + ax * (0.0742610f + ax * -0.0187293f)));
+
+    return (0.0f > x) ? -a : a;
+}
+
+// Dispatch used by the fusion code, libm (or ADL, for Fixed) by default and
+// the approximations above for float when built with USE_FASTMATH.
+template<typename T>
+inline T fusion_sqrt(T x)
+{
+    using std::sqrt;
+    return sqrt(x);
+}
+
+template<typename T>
+inline T fusion_invsqrt(T x)
+{
+    return T(1) / fusion_sqrt(x);
+}
+
+template<typename T>
+inline T fusion_atan2(T y, T x)
+{
+    using std::atan2;
+    return atan2(y, x);
+}
+
+template<typename T>
+inline T fusion_asin(T x)
+{
+    using std::asin;
+    return asin(x);
+}
+
+#ifdef USE_FASTMATH
+template<>
+inline float fusion_sqrt(float x)
+{
+    return fast_sqrt(x);
+}
+
+template<>
+inline float fusion_invsqrt(float x)
+{
+    return fast_invsqrt(x);
+}
+
+template<>
+inline float fusion_atan2(float y, float x)
+{
+    return fast_atan2(y, x);
+}
+
+template<>
+inline float fusion_asin(float x)
+{
+    return fast_asin(x);
+}
+#endif
+
+#endif /* FAST_MATH_H_ */
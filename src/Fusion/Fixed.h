@@ -0,0 +1,191 @@
+#ifndef FIXED_H_
+#define FIXED_H_
+
+#include <stdint.h>
+#include <cmath>
+
+// Signed fixed point number, Q(31-FRAC).FRAC kept in 32 bit. Sums,
+// products and quotients are widened to 64 bit so no precision is lost in 
+// between, and saturate when the result does not fit.
+template<int FRAC>
+class Fixed {
+public:
+    Fixed() : mBits{0} {};
+    Fixed(float val) 
+        : mBits{(int32_t)(val * (float)(1L << FRAC) + (0 > val ? -0.5f : 0.5f))} 
+    {};
+
+    static Fixed fromBits(int32_t bits)
+    {
+        Fixed f;
+
+        f.mBits = bits;
+        return f;
+    }
+
+    // raw register value which has 2^shift LSB per unit
+    static Fixed fromRaw(int16_t raw, int shift)
+    {
+        if (FRAC >= shift)
+        {
+            return fromBits((int32_t)raw * (1L << (FRAC - shift)));
+        }
+        return fromBits((int32_t)raw / (1L << (shift - FRAC)));
+    }
+
+    int32_t bits() const
+    {
+        return mBits;
+    }
+
+    explicit operator float() const
+    {
+        return (float)mBits / (float)(1L << FRAC);
+    }
+
+    friend Fixed operator+(Fixed a, Fixed b)
+    {
+        return saturate((int64_t)a.mBits + b.mBits);
+    }
+
+    friend Fixed operator-(Fixed a, Fixed b)
+    {
+        return saturate((int64_t)a.mBits - b.mBits);
+    }
+
+    friend Fixed operator-(Fixed a)
+    {
+        // -INT32_MIN does not fit either
+        return saturate(-(int64_t)a.mBits);
+    }
+
+    friend Fixed operator*(Fixed a, Fixed b)
+    {
+        return saturate(((int64_t)a.mBits * b.mBits) >> FRAC);
+    }
+
+    friend Fixed operator/(Fixed a, Fixed b)
+    {
+        // saturate instead of trapping
+        if (0 == b.mBits)
+        {
+            return fromBits(0 > a.mBits ? INT32_MIN : INT32_MAX);
+        }
+        return saturate(((int64_t)a.mBits * (1LL << FRAC)) / b.mBits);
+    }
+
+    Fixed& operator+=(Fixed b)
+    {
+        *this = *this + b;
+        return *this;
+    }
+
+    Fixed& operator-=(Fixed b)
+    {
+        *this = *this - b;
+        return *this;
+    }
+
+    friend bool operator<(Fixed a, Fixed b)  { return a.mBits <  b.mBits; }
+    friend bool operator>(Fixed a, Fixed b)  { return a.mBits >  b.mBits; }
+    friend bool operator<=(Fixed a, Fixed b) { return a.mBits <= b.mBits; }
+    friend bool operator>=(Fixed a, Fixed b) { return a.mBits >= b.mBits; }
+    friend bool operator==(Fixed a, Fixed b) { return a.mBits == b.mBits; }
+
+    friend Fixed sqrt(Fixed a)
+    {
+        uint64_t val;
+        uint64_t res;
+        uint64_t bit;
+
+        if (0 >= a.mBits)
+        {
+            return Fixed();
+        }
+
+        // integer square root of the value scaled by 2^FRAC once more
+        val = (uint64_t)a.mBits << FRAC;
+        res = 0;
+        bit = 1ULL << 62;
+        while (bit > val)
+        {
+            bit >>= 2;
+        }
+        while (0 != bit)
+        {
+            if (val >= res + bit)
+            {
+                val -= res + bit;
+                res = (res >> 1) + bit;
+            }
+            else
+            {
+                res >>= 1;
+            }
+            bit >>= 2;
+        }
+
+        return fromBits((int32_t)res);
+    }
+
+    // first octant polynomial, max error 0.0038 rad
+    friend Fixed atan2(Fixed y, Fixed x)
+    {
+        const Fixed pi(M_PI);
+        const Fixed pi2(M_PI / 2);
+        const Fixed pi4(M_PI / 4);
+        const Fixed k(0.2732f);
+        const Fixed one(1.0f);
+        Fixed ax, ay, z, a;
+
+        ax = (0 > x.mBits) ? -x : x;
+        ay = (0 > y.mBits) ? -y : y;
+        if ((0 == ax.mBits) && (0 == ay.mBits))
+        {
+            return Fixed();
+        }
+
+        if (ax >= ay)
+        {
+            z = ay / ax;
+            a = z * (pi4 + k * (one - z));
+        }
+        else
+        {
+            z = ax / ay;
+            a = pi2 - z * (pi4 + k * (one - z));
+        }
+
+        if (0 > x.mBits)
+        {
+            a = pi - a;
+        }
+        if (0 > y.mBits)
+        {
+            a = -a;
+        }
+
+        return a;
+    }
+
+private:
+    int32_t mBits;
+
+    // clamp a widened result back into range instead of wrapping
+    static Fixed saturate(int64_t bits)
+    {
+        if (INT32_MAX < bits)
+        {
+            return fromBits(INT32_MAX);
+        }
+        if (INT32_MIN > bits)
+        {
+            return fromBits(INT32_MIN);
+        }
+        return fromBits((int32_t)bits);
+    }
+};
+
+typedef Fixed<16> Q16_t;
+
+#endif /* FIXED_H_ */
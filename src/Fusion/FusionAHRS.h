@@ -0,0 +1,43 @@
+#ifndef FUSION_AHRS_H_
+#define FUSION_AHRS_H_
+
+#include "Sensor/SensorTypes.h"
+
+// Pipeline filter on top of one of the Adafruit_AHRS filters
+template<typename F>
+class FusionAHRS {
+public:
+    FusionAHRS(float freq)
+        : mFreq{freq}
+    {
+    }
+
+    void begin()
+    {
+        mFilter.begin(mFreq);
+    }
+
+    void update(const sMARG_t* p_marg)
+    {
+        // filter want gyro in dps
+        mFilter.update(p_marg->gyro.x * SENSORS_RADS_TO_DPS, 
+                       p_marg->gyro.y * SENSORS_RADS_TO_DPS, 
+                       p_marg->gyro.z * SENSORS_RADS_TO_DPS, 
+                       p_marg->accl.x, p_marg->accl.y, p_marg->accl.z, 
+                       p_marg->magn.x, p_marg->magn.y, p_marg->magn.z);
+    }
+
+    // the filters keep a quaternion, their euler getters run the trig
+    void getAttitude(sAttitude_t* p_att)
+    {
+        mFilter.getQuaternion(&p_att->quat.w, &p_att->quat.x, 
+                              &p_att->quat.y, &p_att->quat.z);
+        p_att->valid = ATT_QUAT;
+    }
+
+private:
+    F mFilter;
+    float mFreq;
+};
+
+#endif /* FUSION_AHRS_H_ */
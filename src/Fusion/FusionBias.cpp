@@ -0,0 +1,176 @@
+#include "FusionBias.h"
+#include <cmath>
+#include <cstring>
+
+/* private macros ------------------------------------------------------------*/
+#define BIAS_GYRO_ZRO   0.35    // rad/s, MPU6050 zero rate offset bound
+#define BIAS_GYRO_STEP  0.05    // rad/s, drift allowed between two blocks
+#define BIAS_ACCL_ZERO  0.8     // m/s^2, MPU6050 zero-g offset bound
+#define BIAS_GRAV_TOL   0.4     // m/s^2, accel norm off gravity when still
+
+FusionBias::FusionBias(float gyroThres, float acclThres, float alpha)
+    : mGyroThres{gyroThres}
+    , mAcclThres{acclThres}
+    , mAlpha{alpha}
+    , mWindow{1}
+    , mCount{0}
+    , mValid{false}
+    , mAcclValid{false}
+    , mLevel{false}
+{
+    memset(&mBiasGyro, 0x0, sizeof(sensors_vec_t));
+    memset(&mBiasAccl, 0x0, sizeof(sensors_vec_t));
+    memset(&mStillGyro, 0x0, sizeof(sensors_vec_t));
+    memset(&mStillAccl, 0x0, sizeof(sensors_vec_t));
+    reset();
+}
+
+FusionBias::~FusionBias()
+{
+}
+
+void FusionBias::begin(uint32_t window)
+{
+    mWindow = (0 < window) ? window : 1;
+    reset();
+}
+
+void FusionBias::seed(const float gyro[3], const float accl[3])
+{
+    // warm start, still blocks keep refining it
+    for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+    {
+        mBiasGyro.v[u8_k] = gyro[u8_k];
+        mBiasAccl.v[u8_k] = accl[u8_k];
+    }
+    mValid = true;
+    mAcclValid = true;
+}
+
+bool FusionBias::update(const sensors_vec_t* p_gyro, 
+                        const sensors_vec_t* p_accl)
+{
+    bool still = false;
+
+    for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+    {
+        mSumGyro[u8_k] += p_gyro->v[u8_k];
+        mSumAccl[u8_k] += p_accl->v[u8_k];
+
+        // Determine Min / Max values
+        getRange(p_gyro->v[u8_k], mRngGyro[u8_k]);
+        getRange(p_accl->v[u8_k], mRngAccl[u8_k]);
+    }
+
+    if (mWindow <= ++mCount)
+    {
+        still = commit();
+        reset();
+    }
+    return still;
+}
+
+void FusionBias::reset()
+{
+    mCount = 0;
+    for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+    {
+        mSumGyro[u8_k] = 0;
+        mSumAccl[u8_k] = 0;
+        mRngGyro[u8_k][0] =  1e9;
+        mRngGyro[u8_k][1] = -1e9;
+        mRngAccl[u8_k][0] =  1e9;
+        mRngAccl[u8_k][1] = -1e9;
+    }
+}
+
+bool FusionBias::commit()
+{
+    float gyro[3];
+    float accl[3];
+    float norm = 0;
+    float tol;
+
+    // device moved during this block
+    for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+    {
+        if ((mGyroThres < (mRngGyro[u8_k][1] - mRngGyro[u8_k][0])) ||
+            (mAcclThres < (mRngAccl[u8_k][1] - mRngAccl[u8_k][0])))
+        {
+            return false;
+        }
+    }
+
+    // steady rotation, mean is off the bias by more than it can drift
+    for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+    {
+        gyro[u8_k] = mSumGyro[u8_k] / mCount;
+        accl[u8_k] = mSumAccl[u8_k] / mCount;
+        if (mValid ? (BIAS_GYRO_STEP < fabsf(gyro[u8_k] - mBiasGyro.v[u8_k]))
+                   : (BIAS_GYRO_ZRO < fabsf(gyro[u8_k])))
+        {
+            return false;
+        }
+    }
+
+    // constant acceleration, norm is off gravity, unknown accel bias 
+    // widens the band by its bound
+    for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+    {
+        float val = accl[u8_k] - (mAcclValid ? mBiasAccl.v[u8_k] : 0);
+        norm += val * val;
+    }
+    tol = BIAS_GRAV_TOL + (mAcclValid ? 0 : BIAS_ACCL_ZERO);
+    if (tol < fabsf(sqrtf(norm) - SENSORS_GRAVITY_STANDARD))
+    {
+        return false;
+    }
+
+    // flat when only the zero-g offset separates it from [0, 0, g]
+    mLevel = (BIAS_ACCL_ZERO > fabsf(accl[0])) && 
+             (BIAS_ACCL_ZERO > fabsf(accl[1])) &&
+             (BIAS_ACCL_ZERO > fabsf(accl[2] - SENSORS_GRAVITY_STANDARD));
+
+    // gyro keeps following the drift
+    for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+    {
+        mStillGyro.v[u8_k] = gyro[u8_k];
+        mStillAccl.v[u8_k] = accl[u8_k];
+        if (mValid)
+        {
+            mBiasGyro.v[u8_k] += mAlpha * (mStillGyro.v[u8_k] - 
+                                           mBiasGyro.v[u8_k]);
+        }
+        else
+        {
+            mBiasGyro.v[u8_k] = mStillGyro.v[u8_k];
+        }
+    }
+    mValid = true;
+
+    // accel only from the first flat still block, z-axis is 
+    // perpendicular to earth gravity like the boot calibration did
+    if (!mAcclValid && mLevel)
+    {
+        mBiasAccl.x = mStillAccl.x;
+        mBiasAccl.y = mStillAccl.y;
+        mBiasAccl.z = mStillAccl.z - SENSORS_GRAVITY_STANDARD;
+        mAcclValid = true;
+    }
+    return true;
+}
+
+void FusionBias::getRange(float val, float rng[2])
+{
+    // get min value
+    if (val < rng[0])
+    {
+        rng[0] = val;
+    } 
+
+    // get max value
+    if (val > rng[1]) 
+    {
+        rng[1] = val;
+    }
+}
@@ -0,0 +1,83 @@
+#ifndef FUSION_BIAS_H_
+#define FUSION_BIAS_H_
+
+#include "Sensor/SensorTypes.h"
+
+// Background bias estimator. Samples are grouped in blocks of `window`, a 
+// block where every gyro and accel axis stays within its threshold is
+// taken as stationary and its mean refines the bias. A steady rotation or
+// a constant acceleration has a small range too, so the block means must
+// also stay near the known bias and the accel norm near gravity. Accel
+// bias is only taken from a still block lying flat. Memory is constant.
+class FusionBias {
+public:
+    FusionBias(float gyroThres = 0.05, float acclThres = 0.5, 
+               float alpha = 0.2);
+    ~FusionBias();
+
+    void begin(uint32_t window);
+    void seed(const float gyro[3], const float accl[3]);
+    // true when the sample closed a stationary block
+    bool update(const sensors_vec_t* p_gyro, const sensors_vec_t* p_accl);
+
+    bool isValid() const
+    {
+        return mValid && mAcclValid;
+    }
+
+    // last stationary block was flat, z-axis up
+    bool isLevel() const
+    {
+        return mLevel;
+    }
+
+    const sensors_vec_t& getGyro() const
+    {
+        return mBiasGyro;
+    }
+
+    const sensors_vec_t& getAccl() const
+    {
+        return mBiasAccl;
+    }
+
+    // means of the last stationary block, accel still holds gravity
+    const sensors_vec_t& getStillGyro() const
+    {
+        return mStillGyro;
+    }
+
+    const sensors_vec_t& getStillAccl() const
+    {
+        return mStillAccl;
+    }
+
+private:
+    sensors_vec_t mBiasGyro;
+    sensors_vec_t mBiasAccl;
+    sensors_vec_t mStillGyro;
+    sensors_vec_t mStillAccl;
+
+    float mSumGyro[3];
+    float mSumAccl[3];
+    float mRngGyro[3][2];
+    float mRngAccl[3][2];
+
+    float mGyroThres;
+    float mAcclThres;
+    float mAlpha;
+
+    uint32_t mWindow;
+    uint32_t mCount;
+
+    bool mValid;            // gyro bias known
+    bool mAcclValid;        // accel bias known
+    bool mLevel;
+
+    void reset();
+    bool commit();
+
+    void getRange(float val, float rng[2]);
+};
+
+#endif /* FUSION_BIAS_H_ */
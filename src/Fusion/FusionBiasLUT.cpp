@@ -0,0 +1,179 @@
+#include "FusionBiasLUT.h"
+#include <cstring>
+
+/* private macros ------------------------------------------------------------*/
+#define LUT_MIN_WEIGHT  0.5     // a new bin starts from a close sample only
+
+FusionBiasLUT::FusionBiasLUT(float alpha)
+    : mAlpha{alpha}
+    , mRev{0}
+{
+    memset(&mGyro, 0x0, sizeof(sTable_t));
+    memset(&mAccl, 0x0, sizeof(sTable_t));
+}
+
+FusionBiasLUT::~FusionBiasLUT()
+{
+}
+
+void FusionBiasLUT::learnGyro(float temp, const sensors_vec_t* p_gyro)
+{
+    learn(&mGyro, temp, p_gyro);
+}
+
+void FusionBiasLUT::learnAccl(float temp, const sensors_vec_t* p_accl)
+{
+    learn(&mAccl, temp, p_accl);
+}
+
+bool FusionBiasLUT::getGyro(float temp, sensors_vec_t* p_gyro) const
+{
+    return lookup(&mGyro, temp, p_gyro);
+}
+
+bool FusionBiasLUT::getAccl(float temp, sensors_vec_t* p_accl) const
+{
+    return lookup(&mAccl, temp, p_accl);
+}
+
+uint16_t FusionBiasLUT::getGyroTable(float bins[BIAS_LUT_BINS][3]) const
+{
+    return getTable(&mGyro, bins);
+}
+
+uint16_t FusionBiasLUT::getAcclTable(float bins[BIAS_LUT_BINS][3]) const
+{
+    return getTable(&mAccl, bins);
+}
+
+void FusionBiasLUT::setGyroTable(const float bins[BIAS_LUT_BINS][3], 
+                                 uint16_t mask)
+{
+    setTable(&mGyro, bins, mask);
+}
+
+void FusionBiasLUT::setAcclTable(const float bins[BIAS_LUT_BINS][3], 
+                                 uint16_t mask)
+{
+    setTable(&mAccl, bins, mask);
+}
+
+void FusionBiasLUT::learn(sTable_t* p_table, float temp, 
+                          const sensors_vec_t* p_bias)
+{
+    float pos = (temp - BIAS_LUT_TMIN) / BIAS_LUT_STEP;
+    float weight[2];
+    uint8_t bin;
+
+    pos = (0 > pos) ? 0 : (BIAS_LUT_BINS - 1 < pos) ? BIAS_LUT_BINS - 1 : pos;
+    bin = (BIAS_LUT_BINS - 1 <= pos) ? BIAS_LUT_BINS - 2 : (uint8_t)pos;
+    weight[1] = pos - bin;
+    weight[0] = 1 - weight[1];
+
+    // linear split over the bins around temp
+    for (uint8_t u8_n = 0; u8_n < 2; u8_n++)
+    {
+        float* p_bin = p_table->bins[bin + u8_n];
+
+        if (p_table->mask & (1 << (bin + u8_n)))
+        {
+            for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+            {
+                p_bin[u8_k] += mAlpha * weight[u8_n] * 
+                               (p_bias->v[u8_k] - p_bin[u8_k]);
+            }
+        }
+        else if (LUT_MIN_WEIGHT <= weight[u8_n])
+        {
+            memcpy(p_bin, p_bias->v, sizeof(float) * 3);
+            p_table->mask |= (1 << (bin + u8_n));
+            mRev++;
+        }
+    }
+
+    fill(p_table);
+}
+
+bool FusionBiasLUT::lookup(const sTable_t* p_table, float temp, 
+                           sensors_vec_t* p_bias) const
+{
+    float pos = (temp - BIAS_LUT_TMIN) / BIAS_LUT_STEP;
+    float frac;
+    uint8_t bin;
+
+    if (0 == p_table->mask)
+    {
+        return false;
+    }
+
+    pos = (0 > pos) ? 0 : (BIAS_LUT_BINS - 1 < pos) ? BIAS_LUT_BINS - 1 : pos;
+    bin = (BIAS_LUT_BINS - 1 <= pos) ? BIAS_LUT_BINS - 2 : (uint8_t)pos;
+    frac = pos - bin;
+    for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+    {
+        p_bias->v[u8_k] = p_table->dense[bin][u8_k] + frac * 
+            (p_table->dense[bin + 1][u8_k] - p_table->dense[bin][u8_k]);
+    }
+    return true;
+}
+
+uint16_t FusionBiasLUT::getTable(const sTable_t* p_table, 
+                                 float bins[BIAS_LUT_BINS][3]) const
+{
+    memcpy(bins, p_table->bins, sizeof(p_table->bins));
+    return p_table->mask;
+}
+
+void FusionBiasLUT::setTable(sTable_t* p_table, 
+                             const float bins[BIAS_LUT_BINS][3], uint16_t mask)
+{
+    memcpy(p_table->bins, bins, sizeof(p_table->bins));
+    p_table->mask = mask & ((1 << BIAS_LUT_BINS) - 1);
+    fill(p_table);
+}
+
+void FusionBiasLUT::fill(sTable_t* p_table)
+{
+    int8_t lo = -1;
+    int8_t hi;
+    float frac;
+
+    if (0 == p_table->mask)
+    {
+        return;
+    }
+
+    // learned bins as is, gaps interpolated, ends held flat
+    for (int8_t s8_n = 0; s8_n < BIAS_LUT_BINS; s8_n++)
+    {
+        if (p_table->mask & (1 << s8_n))
+        {
+            lo = s8_n;
+            memcpy(p_table->dense[s8_n], p_table->bins[s8_n], sizeof(float) * 3);
+            continue;
+        }
+
+        for (hi = s8_n + 1; hi < BIAS_LUT_BINS; hi++)
+        {
+            if (p_table->mask & (1 << hi))
+            {
+                break;
+            }
+        }
+
+        for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+        {
+            if ((0 <= lo) && (BIAS_LUT_BINS > hi))
+            {
+                frac = (float)(s8_n - lo) / (hi - lo);
+                p_table->dense[s8_n][u8_k] = p_table->bins[lo][u8_k] + frac * 
+                    (p_table->bins[hi][u8_k] - p_table->bins[lo][u8_k]);
+            }
+            else
+            {
+                p_table->dense[s8_n][u8_k] = (0 <= lo) ? 
+                    p_table->bins[lo][u8_k] : p_table->bins[hi][u8_k];
+            }
+        }
+    }
+}
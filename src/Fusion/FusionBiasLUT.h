@@ -0,0 +1,61 @@
+#ifndef FUSION_BIAS_LUT_H_
+#define FUSION_BIAS_LUT_H_
+
+#include "Sensor/SensorTypes.h"
+
+#define BIAS_LUT_BINS   12
+#define BIAS_LUT_TMIN   0.0     // [degC] centre of the first bin
+#define BIAS_LUT_STEP   6.0     // [degC] between bin centres
+
+// Gyro / accel bias keyed by die temperature. Each learned bias is split 
+// over the two bins around its temperature; bins never learned are bridged
+// from their learned neighbours into a dense copy, so a lookup is one 
+// interpolation between two entries. Temperatures clamp to the table ends.
+class FusionBiasLUT {
+public:
+    FusionBiasLUT(float alpha = 0.2);
+    ~FusionBiasLUT();
+
+    void learnGyro(float temp, const sensors_vec_t* p_gyro);
+    void learnAccl(float temp, const sensors_vec_t* p_accl);
+
+    // false until a bin was learned, output untouched then
+    bool getGyro(float temp, sensors_vec_t* p_gyro) const;
+    bool getAccl(float temp, sensors_vec_t* p_accl) const;
+
+    // persistence, mask bit n set for a learned bin n
+    uint16_t getGyroTable(float bins[BIAS_LUT_BINS][3]) const;
+    uint16_t getAcclTable(float bins[BIAS_LUT_BINS][3]) const;
+    void setGyroTable(const float bins[BIAS_LUT_BINS][3], uint16_t mask);
+    void setAcclTable(const float bins[BIAS_LUT_BINS][3], uint16_t mask);
+
+    // bumps whenever a bin is learned for the first time
+    uint32_t getRev() const
+    {
+        return mRev;
+    }
+
+private:
+    typedef struct
+    {
+        float bins[BIAS_LUT_BINS][3];
+        float dense[BIAS_LUT_BINS][3];
+        uint16_t mask;
+    } sTable_t;
+
+    sTable_t mGyro;
+    sTable_t mAccl;
+    float mAlpha;
+    uint32_t mRev;
+
+    void learn(sTable_t* p_table, float temp, const sensors_vec_t* p_bias);
+    bool lookup(const sTable_t* p_table, float temp, 
+                sensors_vec_t* p_bias) const;
+    uint16_t getTable(const sTable_t* p_table, 
+                      float bins[BIAS_LUT_BINS][3]) const;
+    void setTable(sTable_t* p_table, const float bins[BIAS_LUT_BINS][3], 
+                  uint16_t mask);
+    void fill(sTable_t* p_table);
+};
+
+#endif /* FUSION_BIAS_LUT_H_ */
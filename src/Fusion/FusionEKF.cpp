@@ -0,0 +1,186 @@
+#include "FusionEKF.h"
+#include <cstring>
+
+FusionEKF::FusionEKF(float gyroNoise, float biasNoise, float acclNoise)
+    : mGyroVar{gyroNoise * gyroNoise}
+    , mBiasVar{biasNoise * biasNoise}
+    , mAcclVar{acclNoise * acclNoise}
+    , mDirty{false}
+{
+    mQuat = {1.0, 0.0, 0.0, 0.0};
+    memset(&mBias, 0x0, sizeof(sensors_vec_t));
+    memset(&mTiltRads, 0x0, sizeof(sensors_vec_t));
+
+    // unknown attitude, small bias
+    mP = Matrix<7, 7>::identity() * 0.1f;
+    for (uint8_t i = 4; i < 7; i++)
+    {
+        mP(i, i) = 0.001;
+    }
+}
+
+FusionEKF::~FusionEKF()
+{
+}
+
+void FusionEKF::update(const sMARG_t* p_marg, float dt) 
+{
+    predict(&(p_marg->gyro), dt);
+    correct(&(p_marg->accl));
+
+    mDirty = true;
+}
+
+void FusionEKF::update(const sMARGBatch_t* p_batch, uint32_t count) 
+{
+    sMARG_t marg;
+
+    // state chains every sample, gather and run the same step
+    for (uint32_t u32_i = 0; u32_i < count; u32_i++)
+    {
+        marg.gyro.x = p_batch->gyro[0][u32_i];
+        marg.gyro.y = p_batch->gyro[1][u32_i];
+        marg.gyro.z = p_batch->gyro[2][u32_i];
+        marg.accl.x = p_batch->accl[0][u32_i];
+        marg.accl.y = p_batch->accl[1][u32_i];
+        marg.accl.z = p_batch->accl[2][u32_i];
+
+        update(&marg, mDt.next(p_batch->t_us[u32_i]));
+    }
+}
+
+void FusionEKF::predict(const sensors_vec_t* p_gyro, float dt)
+{
+    Matrix<7, 7> F;
+    Matrix<7, 7> Q;
+    sQuaternion_t q;
+    float wx, wy, wz;
+    float h;
+
+    q  = mQuat;
+    wx = p_gyro->x - mBias.x;
+    wy = p_gyro->y - mBias.y;
+    wz = p_gyro->z - mBias.z;
+    h  = 0.5 * dt;
+
+    // q(k+1) = (I + dt/2 * Omega(w)) * q(k)
+    mQuat.w = q.w - h * (q.x*wx + q.y*wy + q.z*wz);
+    mQuat.x = q.x + h * (q.w*wx + q.y*wz - q.z*wy);
+    mQuat.y = q.y + h * (q.w*wy - q.x*wz + q.z*wx);
+    mQuat.z = q.z + h * (q.w*wz + q.x*wy - q.y*wx);
+
+    // jacobian over quaternion
+    F = Matrix<7, 7>::identity();
+    F(0, 1) = -h*wx;  F(0, 2) = -h*wy;  F(0, 3) = -h*wz;
+    F(1, 0) =  h*wx;  F(1, 2) =  h*wz;  F(1, 3) = -h*wy;
+    F(2, 0) =  h*wy;  F(2, 1) = -h*wz;  F(2, 3) =  h*wx;
+    F(3, 0) =  h*wz;  F(3, 1) =  h*wy;  F(3, 2) = -h*wx;
+
+    // jacobian over bias, -dt/2 * Xi(q)
+    F(0, 4) =  h*q.x;  F(0, 5) =  h*q.y;  F(0, 6) =  h*q.z;
+    F(1, 4) = -h*q.w;  F(1, 5) =  h*q.z;  F(1, 6) = -h*q.y;
+    F(2, 4) = -h*q.z;  F(2, 5) = -h*q.w;  F(2, 6) =  h*q.x;
+    F(3, 4) =  h*q.y;  F(3, 5) = -h*q.x;  F(3, 6) = -h*q.w;
+
+    // gyro noise maps through dt/2 on the quaternion, bias random walk
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        Q(i, i) = h * h * mGyroVar;
+    }
+    for (uint8_t i = 4; i < 7; i++)
+    {
+        Q(i, i) = dt * mBiasVar;
+    }
+
+    mP = F * mP * F.transpose() + Q;
+}
+
+void FusionEKF::correct(const sensors_vec_t* p_accl)
+{
+    Matrix<3, 7> H;
+    Matrix<7, 3> K;
+    Matrix<3, 3> S;
+    Matrix<3, 3> Si;
+    Matrix<3, 1> y;
+    Matrix<7, 1> dx;
+    sQuaternion_t q;
+    float norm;
+
+    // free fall, nothing to measure
+    norm = p_accl->x*p_accl->x + p_accl->y*p_accl->y + p_accl->z*p_accl->z;
+    if (0 >= norm)
+    {
+        return;
+    }
+    norm = fusion_invsqrt(norm);
+
+    // innovation between measured and predicted gravity direction
+    q = mQuat;
+    y(0, 0) = p_accl->x * norm - 2.0f * (q.x*q.z - q.w*q.y);
+    y(1, 0) = p_accl->y * norm - 2.0f * (q.w*q.x + q.y*q.z);
+    y(2, 0) = p_accl->z * norm - (q.w*q.w - q.x*q.x - q.y*q.y + q.z*q.z);
+
+    H(0, 0) = -2*q.y;  H(0, 1) =  2*q.z;  H(0, 2) = -2*q.w;  H(0, 3) =  2*q.x;
+    H(1, 0) =  2*q.x;  H(1, 1) =  2*q.w;  H(1, 2) =  2*q.z;  H(1, 3) =  2*q.y;
+    H(2, 0) =  2*q.w;  H(2, 1) = -2*q.x;  H(2, 2) = -2*q.y;  H(2, 3) =  2*q.z;
+
+    S = H * mP * H.transpose() + Matrix<3, 3>::identity() * mAcclVar;
+    if (!invert(S, &Si))
+    {
+        return;
+    }
+
+    K  = mP * H.transpose() * Si;
+    dx = K * y;
+    mP = (Matrix<7, 7>::identity() - K * H) * mP;
+
+    // keep covariance symmetric against rounding
+    mP = (mP + mP.transpose()) * 0.5f;
+
+    mQuat.w += dx(0, 0);
+    mQuat.x += dx(1, 0);
+    mQuat.y += dx(2, 0);
+    mQuat.z += dx(3, 0);
+    mBias.x += dx(4, 0);
+    mBias.y += dx(5, 0);
+    mBias.z += dx(6, 0);
+
+    // normalise quaternion
+    norm = fusion_invsqrt(mQuat.w*mQuat.w + mQuat.x*mQuat.x + 
+                          mQuat.y*mQuat.y + mQuat.z*mQuat.z);
+    mQuat.w *= norm;
+    mQuat.x *= norm;
+    mQuat.y *= norm;
+    mQuat.z *= norm;
+}
+
+const sensors_vec_t& FusionEKF::getTilt()
+{
+    const sQuaternion_t& q = mQuat;
+    float sinp;
+
+    if (mDirty)
+    {
+        mDirty = false;
+
+        mTiltRads.roll    = fusion_atan2(2.0f * (q.w*q.x + q.y*q.z), 
+                                         1.0f - 2.0f * (q.x*q.x + q.y*q.y));
+
+        // clamp against rounding at +/-90 deg
+        sinp = 2.0 * (q.w*q.y - q.z*q.x);
+        if (1.0 < sinp)
+        {
+            sinp = 1.0;
+        }
+        else if (-1.0 > sinp)
+        {
+            sinp = -1.0;
+        }
+        mTiltRads.pitch   = fusion_asin(sinp);
+
+        mTiltRads.heading = fusion_atan2(2.0f * (q.w*q.z + q.x*q.y), 
+                                         1.0f - 2.0f * (q.y*q.y + q.z*q.z));
+    }
+
+    return mTiltRads;
+}
@@ -0,0 +1,50 @@
+#ifndef FUSION_EKF_H_
+#define FUSION_EKF_H_
+
+#include "FusionTypes.h"
+#include "Matrix.h"
+
+// Extended Kalman filter over attitude quaternion and gyro bias, 
+// x = [qw qx qy qz bx by bz]. Gyro drives the prediction, normalised 
+// accelerometer (gravity direction) is the measurement.
+class FusionEKF {
+public:
+    FusionEKF(float gyroNoise = 0.005, float biasNoise = 0.0001, 
+              float acclNoise = 0.1);
+    ~FusionEKF();
+
+    void update(const sMARG_t* p_marg, float dt);
+    void update(const sMARGBatch_t* p_batch, uint32_t count);
+
+    const sQuaternion_t& getQuat() const
+    {
+        return mQuat;
+    }
+
+    const sensors_vec_t& getBias() const
+    {
+        return mBias;
+    }
+
+    const sensors_vec_t& getTilt();
+
+private:
+    Matrix<7, 7> mP;
+
+    sQuaternion_t mQuat;
+    sensors_vec_t mBias;
+    sensors_vec_t mTiltRads;
+
+    float mGyroVar;
+    float mBiasVar;
+    float mAcclVar;
+
+    bool mDirty;
+
+    FusionDt<float> mDt;
+
+    void predict(const sensors_vec_t* p_gyro, float dt);
+    void correct(const sensors_vec_t* p_accl);
+};
+
+#endif /* FUSION_EKF_H_ */
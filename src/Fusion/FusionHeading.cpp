@@ -0,0 +1,80 @@
+#include "FusionHeading.h"
+
+template<typename T>
+FusionHeadingT<T>::FusionHeadingT(float declDeg, float declMin)
+    : mHeading{0}
+{
+    // Set declination angle on your location and fix heading
+    // You can find your declination on: http://magnetic-declination.com/
+    mDeclAngle = (declDeg + (declMin / 60.0)) * SENSORS_DPS_TO_RADS;
+}
+
+template<typename T>
+FusionHeadingT<T>::~FusionHeadingT()
+{
+}
+
+template<typename T>
+void FusionHeadingT<T>::update(const sample_t* p_marg) 
+{
+    const auto* p_mag = &(p_marg->magn);
+    T yaw;
+
+    yaw = fusion_atan2(p_mag->x, 
+                       fusion_sqrt(p_mag->y*p_mag->y + p_mag->z*p_mag->z));
+    
+    // fix heading in current location
+    yaw += mDeclAngle;
+    
+    // correct angle
+    mHeading = fixAngle(yaw);
+}
+
+template<typename T>
+void FusionHeadingT<T>::update(const sMARGBatchT<T>* p_batch, uint32_t count) 
+{
+    const T* mx = p_batch->magn[0];
+    const T* my = p_batch->magn[1];
+    const T* mz = p_batch->magn[2];
+    uint32_t last;
+    T yaw;
+
+    // heading carries no state, only the newest sample matters
+    if (0 == count)
+    {
+        return;
+    }
+    last = count - 1;
+
+    yaw = fusion_atan2(mx[last], 
+                       fusion_sqrt(my[last]*my[last] + mz[last]*mz[last]));
+
+    // fix heading in current location
+    yaw += mDeclAngle;
+
+    // correct angle
+    mHeading = fixAngle(yaw);
+}
+
+template<typename T>
+T FusionHeadingT<T>::fixAngle(T heading)
+{
+    const T pi2(2.0 * M_PI);
+
+    // Correct for when signs are reversed.
+    if (0 > heading)
+    {
+        heading += pi2;
+    }
+        
+    // Check for wrap due to addition of declination.
+    else if (pi2 < heading)
+    {
+        heading -= pi2;
+    }
+
+    return (heading);
+}
+
+template class FusionHeadingT<float>;
+template class FusionHeadingT<Q16_t>;
@@ -0,0 +1,33 @@
+#ifndef FUSION_HEADING_H_
+#define FUSION_HEADING_H_
+
+#include "FusionTypes.h"
+
+template<typename T>
+class FusionHeadingT {
+public:
+    typedef typename FusionSample<T>::type sample_t;
+
+    FusionHeadingT(float declDeg, float declMin);
+    ~FusionHeadingT();
+
+    void update(const sample_t* p_marg);
+    void update(const sMARGBatchT<T>* p_batch, uint32_t count);
+
+    T getHeading() const
+    {
+        return mHeading;
+    }
+
+private:
+    T mDeclAngle;
+    T mHeading;
+
+    T fixAngle(T heading);
+
+};
+
+typedef FusionHeadingT<float> FusionHeading;
+typedef FusionHeadingT<Q16_t> FusionHeadingQ;
+
+#endif /* FUSION_HEADING_H_ */
@@ -0,0 +1,206 @@
+#include "FusionMagFit.h"
+#include <cstring>
+#include <cmath>
+
+/* private macros ------------------------------------------------------------*/
+#define MAGFIT_P0       100.0   // initial covariance
+#define MAGFIT_P_MAX    1e4     // stop forgetting above, no excitation
+#define MAGFIT_P_CONV   (MAGFIT_P0 * 9 * 0.01)  // covariance trace, settled
+#define MAGFIT_RES_TAU  0.02    // residual average, per sample weight
+#define MAGFIT_RES_MAX  0.05    // rms of the normalised residual
+#define MAGFIT_COVER    1.0     // per axis spread seen, in fitted radii
+
+FusionMagFit::FusionMagFit(float scale, float lambda, uint32_t solveCnt)
+    : mScale{scale}
+    , mLambda{lambda}
+    , mSolveCnt{solveCnt}
+{
+    // typical earth field, 50uT
+    reset(50.0);
+}
+
+FusionMagFit::~FusionMagFit()
+{
+}
+
+void FusionMagFit::reset(float radius)
+{
+    float r;
+
+    // start from a sphere around origin
+    r = radius * mScale;
+    mTheta.fill(0);
+    mTheta(0, 0) = 1.0 / (r * r);
+    mTheta(1, 0) = 1.0 / (r * r);
+    mTheta(2, 0) = 1.0 / (r * r);
+
+    mP = Matrix<9, 9>::identity() * MAGFIT_P0;
+    mSoftIron = Matrix<3, 3>::identity();
+    memset(&mOffset, 0x0, sizeof(sensors_vec_t));
+
+    // coverage of the samples behind the fit, not of the prior
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        mRng[i][0] =  1e9;
+        mRng[i][1] = -1e9;
+    }
+    mRes = 1.0;
+    mTrace = 9 * MAGFIT_P0;
+
+    mCount = 0;
+    mValid = false;
+}
+
+void FusionMagFit::update(const sensors_vec_t* p_magn)
+{
+    Matrix<9, 1> phi;
+    Matrix<9, 1> Pphi;
+    Matrix<9, 1> k;
+    float x, y, z;
+    float denom;
+    float err;
+    float trace;
+
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        mRng[i][0] = fminf(mRng[i][0], p_magn->v[i]);
+        mRng[i][1] = fmaxf(mRng[i][1], p_magn->v[i]);
+    }
+
+    // scaled so every regressor is around unity
+    x = p_magn->x * mScale;
+    y = p_magn->y * mScale;
+    z = p_magn->z * mScale;
+
+    phi(0, 0) = x*x;
+    phi(1, 0) = y*y;
+    phi(2, 0) = z*z;
+    phi(3, 0) = 2*x*y;
+    phi(4, 0) = 2*x*z;
+    phi(5, 0) = 2*y*z;
+    phi(6, 0) = 2*x;
+    phi(7, 0) = 2*y;
+    phi(8, 0) = 2*z;
+
+    // gain
+    Pphi  = mP * phi;
+    denom = mLambda + (phi.transpose() * Pphi)(0, 0);
+    k     = Pphi * (1.0f / denom);
+
+    // parameter and covariance update, target is always 1
+    err    = 1.0f - (phi.transpose() * mTheta)(0, 0);
+    mTheta = mTheta + k * err;
+    mP     = mP - k * Pphi.transpose();
+
+    // a priori residual, 2 * noise / radius once the fit holds
+    mRes += MAGFIT_RES_TAU * (err * err - mRes);
+
+    // forget old samples only while the covariance stays bounded
+    trace = 0;
+    for (uint8_t i = 0; i < 9; i++)
+    {
+        trace += mP(i, i);
+    }
+    if (MAGFIT_P_MAX > trace)
+    {
+        mP = mP * (1.0f / mLambda);
+    }
+    mTrace = trace;
+
+    if (mSolveCnt <= ++mCount)
+    {
+        mCount = 0;
+        mValid = solve() || mValid;
+    }
+}
+
+void FusionMagFit::correct(sensors_vec_t* p_magn) const
+{
+    float m[3];
+
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        m[i] = p_magn->v[i] - mOffset.v[i];
+    }
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        p_magn->v[i] = mSoftIron(i, 0) * m[0] + 
+                       mSoftIron(i, 1) * m[1] + 
+                       mSoftIron(i, 2) * m[2];
+    }
+}
+
+bool FusionMagFit::solve()
+{
+    Matrix<3, 3> M;
+    Matrix<3, 3> Mi;
+    Matrix<3, 3> V;
+    Matrix<3, 3> D;
+    Matrix<3, 1> v;
+    Matrix<3, 1> c;
+    float val[3];
+    float k;
+    float det;
+    float radius;
+
+    M(0, 0) = mTheta(0, 0);
+    M(1, 1) = mTheta(1, 0);
+    M(2, 2) = mTheta(2, 0);
+    M(0, 1) = M(1, 0) = mTheta(3, 0);
+    M(0, 2) = M(2, 0) = mTheta(4, 0);
+    M(1, 2) = M(2, 1) = mTheta(5, 0);
+    v(0, 0) = mTheta(6, 0);
+    v(1, 0) = mTheta(7, 0);
+    v(2, 0) = mTheta(8, 0);
+
+    // centre of the ellipsoid
+    if (!invert(M, &Mi))
+    {
+        return false;
+    }
+    c = (Mi * v) * -1.0f;
+
+    // (m-c)' * M/k * (m-c) = 1
+    k = 1.0f + (c.transpose() * M * c)(0, 0);
+    if (0 >= k)
+    {
+        return false;
+    }
+
+    // not an ellipsoid (yet)
+    eigenSym(M * (1.0f / k), &V, val);
+    if ((0 >= val[0]) || (0 >= val[1]) || (0 >= val[2]))
+    {
+        return false;
+    }
+
+    // the prior alone solves to a sphere, only accept what the samples 
+    // pinned down: settled covariance, small residual, all axes swept
+    det = val[0] * val[1] * val[2];
+    radius = 1.0f / (cbrtf(sqrtf(det)) * mScale);
+    if ((MAGFIT_P_CONV < mTrace) || (MAGFIT_RES_MAX * MAGFIT_RES_MAX < mRes))
+    {
+        return false;
+    }
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        if (MAGFIT_COVER * radius > mRng[i][1] - mRng[i][0])
+        {
+            return false;
+        }
+    }
+
+    // W = sqrt(M/k), normalised to unit determinant so field keeps its size
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        D(i, i) = sqrtf(val[i]) / cbrtf(sqrtf(det));
+    }
+    mSoftIron = V * D * V.transpose();
+
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        mOffset.v[i] = c(i, 0) / mScale;
+    }
+
+    return true;
+}
@@ -0,0 +1,57 @@
+#ifndef FUSION_MAG_FIT_H_
+#define FUSION_MAG_FIT_H_
+
+#include "Sensor/SensorTypes.h"
+#include "Matrix.h"
+
+// Streaming magnetometer calibration. Recursive least squares fit of the
+// quadric  a.x2 + b.y2 + c.z2 + 2d.xy + 2e.xz + 2f.yz + 2g.x + 2h.y + 2i.z = 1
+// one sample at a time in constant memory, solved every few samples into a
+// hard iron offset and a symmetric soft iron matrix: m' = W * (m - offset).
+class FusionMagFit {
+public:
+    FusionMagFit(float scale = 0.01, float lambda = 0.9999, 
+                 uint32_t solveCnt = 50);
+    ~FusionMagFit();
+
+    void reset(float radius);
+    void update(const sensors_vec_t* p_magn);
+    void correct(sensors_vec_t* p_magn) const;
+
+    bool isValid() const
+    {
+        return mValid;
+    }
+
+    const sensors_vec_t& getOffset() const
+    {
+        return mOffset;
+    }
+
+    const Matrix<3, 3>& getSoftIron() const
+    {
+        return mSoftIron;
+    }
+
+private:
+    Matrix<9, 9> mP;
+    Matrix<9, 1> mTheta;
+    Matrix<3, 3> mSoftIron;
+    sensors_vec_t mOffset;
+
+    float mScale;
+    float mLambda;
+
+    uint32_t mSolveCnt;
+    uint32_t mCount;
+
+    float mRng[3][2];       // raw min / max per axis since reset
+    float mRes;             // mean square a priori residual
+    float mTrace;           // covariance trace
+
+    bool mValid;
+
+    bool solve();
+};
+
+#endif /* FUSION_MAG_FIT_H_ */
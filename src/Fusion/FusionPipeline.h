@@ -0,0 +1,73 @@
+#ifndef FUSION_PIPELINE_H_
+#define FUSION_PIPELINE_H_
+
+#include "Sensor/SensorTypes.h"
+#include "Profile/LoopProfiler.h"
+
+// Per sample chain wired at compile time, every stage is a concrete type so
+// the calls inline into step(). Stages only need these members:
+//   Source : init(count), wait(), bool getEvent(sMARG_t*)
+//   Filter : begin(), update(const sMARG_t*), getAttitude(sAttitude_t*)
+//   Sink   : due(), report(sAttitude_t*)
+// Source and Filter may be the same object. getAttitude() hands out the
+// filter state as is, readers convert it with completeAttitude().
+template<typename Source, typename Filter, typename Sink>
+class FusionPipeline {
+public:
+    FusionPipeline(Source& source, Filter& filter, Sink& sink)
+        : mSource{source}
+        , mFilter{filter}
+        , mSink{sink}
+    {
+    }
+
+    void init(uint32_t count)
+    {
+        mSource.init(count);
+        mFilter.begin();
+    }
+
+    void step()
+    {
+        sAttitude_t sample;
+        PROF_SCOPE(PROF_STEP);
+
+        // wait until sample time
+        {
+            PROF_SCOPE(PROF_WAIT);
+            mSource.wait();
+        }
+
+        // get sensor events
+        mSource.getEvent(&mMarg);
+
+        // update current position
+        {
+            PROF_SCOPE(PROF_UPDATE);
+            mFilter.update(&mMarg);
+        }
+
+        // reporting
+        if (mSink.due())
+        {
+            sample.marg = mMarg;
+            mFilter.getAttitude(&sample);
+
+            mSink.report(&sample);
+        }
+    }
+
+    const sMARG_t& getMARG() const
+    {
+        return mMarg;
+    }
+
+private:
+    Source& mSource;
+    Filter& mFilter;
+    Sink& mSink;
+
+    sMARG_t mMarg;
+};
+
+#endif /* FUSION_PIPELINE_H_ */
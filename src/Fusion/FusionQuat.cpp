@@ -0,0 +1,141 @@
+#include "FusionQuat.h"
+#include "FastMath.h"
+#include <cstring>
+
+FusionQuat::FusionQuat(float kp, float ki)
+    : mKp{kp}
+    , mKi{ki}
+    , mDirty{false}
+{
+    mQuat = {1.0, 0.0, 0.0, 0.0};
+    memset(&mIntegral, 0x0, sizeof(sensors_vec_t));
+    memset(&mTiltRads, 0x0, sizeof(sensors_vec_t));
+}
+
+FusionQuat::~FusionQuat()
+{
+}
+
+void FusionQuat::update(const sMARG_t* p_marg, float dt) 
+{
+    const sensors_vec_t* p_accl;
+    const sensors_vec_t* p_gyro;
+    sQuaternion_t q;
+    float ax, ay, az;
+    float gx, gy, gz;
+    float vx, vy, vz;
+    float ex, ey, ez;
+    float norm;
+
+    p_accl = &(p_marg->accl);
+    p_gyro = &(p_marg->gyro);
+    q = mQuat;
+
+    gx = p_gyro->x;
+    gy = p_gyro->y;
+    gz = p_gyro->z;
+
+    // accelerometer feedback, skipped on free fall
+    norm = p_accl->x*p_accl->x + p_accl->y*p_accl->y + p_accl->z*p_accl->z;
+    if (0 < norm)
+    {
+        norm = fusion_invsqrt(norm);
+        ax = p_accl->x * norm;
+        ay = p_accl->y * norm;
+        az = p_accl->z * norm;
+
+        // estimated direction of gravity
+        vx = 2.0 * (q.x*q.z - q.w*q.y);
+        vy = 2.0 * (q.w*q.x + q.y*q.z);
+        vz = q.w*q.w - q.x*q.x - q.y*q.y + q.z*q.z;
+
+        // error is cross product between estimated and measured gravity
+        ex = ay*vz - az*vy;
+        ey = az*vx - ax*vz;
+        ez = ax*vy - ay*vx;
+
+        // integral feedback
+        if (0 < mKi)
+        {
+            mIntegral.x += mKi * ex * dt;
+            mIntegral.y += mKi * ey * dt;
+            mIntegral.z += mKi * ez * dt;
+            gx += mIntegral.x;
+            gy += mIntegral.y;
+            gz += mIntegral.z;
+        }
+
+        // proportional feedback
+        gx += mKp * ex;
+        gy += mKp * ey;
+        gz += mKp * ez;
+    }
+
+    // integrate rate of change of quaternion
+    gx *= 0.5 * dt;
+    gy *= 0.5 * dt;
+    gz *= 0.5 * dt;
+    mQuat.w = q.w - q.x*gx - q.y*gy - q.z*gz;
+    mQuat.x = q.x + q.w*gx + q.y*gz - q.z*gy;
+    mQuat.y = q.y + q.w*gy - q.x*gz + q.z*gx;
+    mQuat.z = q.z + q.w*gz + q.x*gy - q.y*gx;
+
+    // normalise quaternion
+    norm = fusion_invsqrt(mQuat.w*mQuat.w + mQuat.x*mQuat.x + 
+                          mQuat.y*mQuat.y + mQuat.z*mQuat.z);
+    mQuat.w *= norm;
+    mQuat.x *= norm;
+    mQuat.y *= norm;
+    mQuat.z *= norm;
+
+    mDirty = true;
+}
+
+void FusionQuat::update(const sMARGBatch_t* p_batch, uint32_t count) 
+{
+    sMARG_t marg;
+
+    // quaternion state chains every sample, gather and run the same step
+    for (uint32_t u32_i = 0; u32_i < count; u32_i++)
+    {
+        marg.gyro.x = p_batch->gyro[0][u32_i];
+        marg.gyro.y = p_batch->gyro[1][u32_i];
+        marg.gyro.z = p_batch->gyro[2][u32_i];
+        marg.accl.x = p_batch->accl[0][u32_i];
+        marg.accl.y = p_batch->accl[1][u32_i];
+        marg.accl.z = p_batch->accl[2][u32_i];
+
+        update(&marg, mDt.next(p_batch->t_us[u32_i]));
+    }
+}
+
+const sensors_vec_t& FusionQuat::getTilt()
+{
+    const sQuaternion_t& q = mQuat;
+    float sinp;
+
+    if (mDirty)
+    {
+        mDirty = false;
+
+        mTiltRads.roll    = fusion_atan2(2.0f * (q.w*q.x + q.y*q.z), 
+                                         1.0f - 2.0f * (q.x*q.x + q.y*q.y));
+
+        // clamp against rounding at +/-90 deg
+        sinp = 2.0 * (q.w*q.y - q.z*q.x);
+        if (1.0 < sinp)
+        {
+            sinp = 1.0;
+        }
+        else if (-1.0 > sinp)
+        {
+            sinp = -1.0;
+        }
+        mTiltRads.pitch   = fusion_asin(sinp);
+
+        mTiltRads.heading = fusion_atan2(2.0f * (q.w*q.z + q.x*q.y), 
+                                         1.0f - 2.0f * (q.y*q.y + q.z*q.z));
+    }
+
+    return mTiltRads;
+}
@@ -0,0 +1,37 @@
+#ifndef FUSION_QUAT_H_
+#define FUSION_QUAT_H_
+
+#include "FusionTypes.h"
+
+// Mahony style complementary filter, the orientation is kept as quaternion
+// so the per sample path needs no trigonometry, Euler angles are only 
+// computed when asked for.
+class FusionQuat {
+public:
+    FusionQuat(float kp, float ki);
+    ~FusionQuat();
+
+    void update(const sMARG_t* p_marg, float dt);
+    void update(const sMARGBatch_t* p_batch, uint32_t count);
+
+    const sQuaternion_t& getQuat() const
+    {
+        return mQuat;
+    }
+
+    const sensors_vec_t& getTilt();
+
+private:
+    sQuaternion_t mQuat;
+    sensors_vec_t mIntegral;
+    sensors_vec_t mTiltRads;
+
+    float mKp;
+    float mKi;
+
+    bool mDirty;
+
+    FusionDt<float> mDt;
+};
+
+#endif /* FUSION_QUAT_H_ */
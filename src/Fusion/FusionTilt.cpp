@@ -0,0 +1,80 @@
+#include "FusionTilt.h"
+
+template<typename T>
+FusionTiltT<T>::FusionTiltT(T fltrTau)
+    : mTiltRads{T(0), T(0), T(0)}
+    , mFltrTau{fltrTau}
+{
+}
+
+template<typename T>
+FusionTiltT<T>::~FusionTiltT()
+{
+}
+
+template<typename T>
+void FusionTiltT<T>::update(const sample_t* p_marg, T dt) 
+{
+    const auto* p_accl = &(p_marg->accl);
+    const auto* p_gyro = &(p_marg->gyro);
+    sTiltT<T> tiltAccl;
+    sTiltT<T> tiltGyro;
+
+    // get tilt from gyroscope
+    tiltGyro.roll    = mTiltRads.roll    + p_gyro->x * dt;
+    tiltGyro.pitch   = mTiltRads.pitch   + p_gyro->y * dt;
+
+    // get tilt from accelerometer
+    tiltAccl.roll    =  fusion_atan2(p_accl->y, 
+                        fusion_sqrt(p_accl->x*p_accl->x + p_accl->z*p_accl->z));
+    tiltAccl.pitch   = -fusion_atan2(p_accl->x, 
+                        fusion_sqrt(p_accl->y*p_accl->y + p_accl->z*p_accl->z));
+
+    // sensor fusion using complementary filter
+    mTiltRads.roll   = (mFltrTau)   * (tiltGyro.roll)  + 
+                       (1-mFltrTau) * (tiltAccl.roll);
+    mTiltRads.pitch  = (mFltrTau)   * (tiltGyro.pitch) + 
+                       (1-mFltrTau) * (tiltAccl.pitch);
+    
+    // undefined for yaw
+    mTiltRads.heading = 0;
+}
+
+template<typename T>
+void FusionTiltT<T>::update(const sMARGBatchT<T>* p_batch, uint32_t count) 
+{
+    const T* ax = p_batch->accl[0];
+    const T* ay = p_batch->accl[1];
+    const T* az = p_batch->accl[2];
+    const T* gx = p_batch->gyro[0];
+    const T* gy = p_batch->gyro[1];
+    T accRoll[MARG_BATCH_MAX];
+    T accPitch[MARG_BATCH_MAX];
+    T dt;
+
+    // get tilt from accelerometer, no dependency between samples
+    for (uint32_t u32_i = 0; u32_i < count; u32_i++)
+    {
+        accRoll[u32_i]  =  fusion_atan2(ay[u32_i], 
+                           fusion_sqrt(ax[u32_i]*ax[u32_i] + az[u32_i]*az[u32_i]));
+        accPitch[u32_i] = -fusion_atan2(ax[u32_i], 
+                           fusion_sqrt(ay[u32_i]*ay[u32_i] + az[u32_i]*az[u32_i]));
+    }
+
+    // integrate gyroscope and fuse, carries state from sample to sample
+    for (uint32_t u32_i = 0; u32_i < count; u32_i++)
+    {
+        dt = mDt.next(p_batch->t_us[u32_i]);
+
+        mTiltRads.roll  = (mFltrTau)   * (mTiltRads.roll + gx[u32_i] * dt) + 
+                          (1-mFltrTau) * (accRoll[u32_i]);
+        mTiltRads.pitch = (mFltrTau)   * (mTiltRads.pitch + gy[u32_i] * dt) + 
+                          (1-mFltrTau) * (accPitch[u32_i]);
+    }
+
+    // undefined for yaw
+    mTiltRads.heading = 0;
+}
+
+template class FusionTiltT<float>;
+template class FusionTiltT<Q16_t>;
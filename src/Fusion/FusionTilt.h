@@ -0,0 +1,33 @@
+#ifndef FUSION_TILT_H_
+#define FUSION_TILT_H_
+
+#include "FusionTypes.h"
+
+template<typename T>
+class FusionTiltT {
+public:
+    typedef typename FusionSample<T>::type sample_t;
+
+    FusionTiltT(T fltrTau);
+    ~FusionTiltT();
+
+    void update(const sample_t* p_marg, T dt);
+    void update(const sMARGBatchT<T>* p_batch, uint32_t count);
+
+    const sTiltT<T>& getTilt() const
+    {
+        return mTiltRads;
+    }
+
+private:
+    sTiltT<T> mTiltRads;
+
+    T mFltrTau;
+
+    FusionDt<T> mDt;
+};
+
+typedef FusionTiltT<float> FusionTilt;
+typedef FusionTiltT<Q16_t> FusionTiltQ;
+
+#endif /* FUSION_TILT_H_ */
@@ -0,0 +1,191 @@
+#ifndef FUSION_TYPES_H_
+#define FUSION_TYPES_H_
+
+#include "Sensor/SensorTypes.h"
+#include "Fixed.h"
+#include "FastMath.h"
+
+template<typename T>
+struct sVec3T
+{
+    T x;
+    T y;
+    T z;
+};
+
+template<typename T>
+struct sMARGT
+{
+    sVec3T<T> magn;
+    sVec3T<T> gyro;
+    sVec3T<T> accl;
+};
+
+template<typename T>
+struct sTiltT
+{
+    T roll;
+    T pitch;
+    T heading;
+};
+
+typedef sMARGT<Q16_t> sMARGQ_t;
+
+#define MARG_BATCH_MAX  32
+
+// struct of arrays for a burst of samples, [0..2] index is x,y,z
+template<typename T>
+struct sMARGBatchT
+{
+    uint32_t t_us[MARG_BATCH_MAX];
+    T magn[3][MARG_BATCH_MAX];
+    T gyro[3][MARG_BATCH_MAX];
+    T accl[3][MARG_BATCH_MAX];
+};
+
+typedef sMARGBatchT<float> sMARGBatch_t;
+typedef sMARGBatchT<Q16_t> sMARGBatchQ_t;
+
+// sampling period out of batch timestamps, continues across batches
+template<typename T>
+class FusionDt {
+public:
+    FusionDt() : mLast_us{0}, mValid{false} {};
+
+    T next(uint32_t t_us)
+    {
+        T dt(0);
+
+        if (mValid)
+        {
+            dt = T((float)(uint32_t)(t_us - mLast_us) * 1e-6f);
+        }
+        mLast_us = t_us;
+        mValid = true;
+
+        return dt;
+    }
+
+private:
+    uint32_t mLast_us;
+    bool mValid;
+};
+
+// sample type each scalar works on, float keeps the Adafruit layout
+template<typename T>
+struct FusionSample
+{
+    typedef sMARGT<T> type;
+};
+
+template<>
+struct FusionSample<float>
+{
+    typedef sMARG_t type;
+};
+
+// MPU6050 raw counts: accel 2^14 LSB/g (2G range) to g, gyro 131 LSB/dps 
+// (250DPS range) to rad/s, HMC5883 counts are only scaled down to keep 
+// their squares in range since heading needs the ratio only
+inline void toMARGQ(const int16_t accl[3], const int16_t gyro[3], 
+                    const int16_t magn[3], sMARGQ_t* p_marg)
+{
+    // rad/s per LSB scaled by 2^32, leaves Q16 after the shift
+    const int64_t gyroScale = (int64_t)(SENSORS_DPS_TO_RADS / 131.0 * 4294967296.0);
+
+    p_marg->accl.x = Q16_t::fromRaw(accl[0], 14);
+    p_marg->accl.y = Q16_t::fromRaw(accl[1], 14);
+    p_marg->accl.z = Q16_t::fromRaw(accl[2], 14);
+    p_marg->gyro.x = Q16_t::fromBits((int32_t)((gyro[0] * gyroScale) >> 16));
+    p_marg->gyro.y = Q16_t::fromBits((int32_t)((gyro[1] * gyroScale) >> 16));
+    p_marg->gyro.z = Q16_t::fromBits((int32_t)((gyro[2] * gyroScale) >> 16));
+    p_marg->magn.x = Q16_t::fromRaw(magn[0], 8);
+    p_marg->magn.y = Q16_t::fromRaw(magn[1], 8);
+    p_marg->magn.z = Q16_t::fromRaw(magn[2], 8);
+}
+
+// ZYX euler angles in degrees (as reported) back to a unit quaternion, 
+// same convention FusionQuat uses for getTilt()
+inline void toQuat(const sensors_vec_t* p_tilt, sQuaternion_t* p_quat)
+{
+    const float half = 0.5f * SENSORS_DPS_TO_RADS;
+    float cr = cosf(half * p_tilt->roll);
+    float sr = sinf(half * p_tilt->roll);
+    float cp = cosf(half * p_tilt->pitch);
+    float sp = sinf(half * p_tilt->pitch);
+    float cy = cosf(half * p_tilt->heading);
+    float sy = sinf(half * p_tilt->heading);
+
+    p_quat->w = cr*cp*cy + sr*sp*sy;
+    p_quat->x = sr*cp*cy - cr*sp*sy;
+    p_quat->y = cr*sp*cy + sr*cp*sy;
+    p_quat->z = cr*cp*sy - sr*sp*cy;
+}
+
+// unit quaternion to ZYX euler angles in degrees, inverse of toQuat()
+inline void toTilt(const sQuaternion_t* p_quat, sensors_vec_t* p_tilt)
+{
+    const sQuaternion_t& q = *p_quat;
+    float sinp = 2.0f * (q.w*q.y - q.z*q.x);
+
+    // clamp against rounding at +/-90 deg
+    if (1.0f < sinp)
+    {
+        sinp = 1.0f;
+    }
+    else if (-1.0f > sinp)
+    {
+        sinp = -1.0f;
+    }
+
+    p_tilt->roll    = fusion_atan2(2.0f * (q.w*q.x + q.y*q.z), 
+                                   1.0f - 2.0f * (q.x*q.x + q.y*q.y));
+    p_tilt->pitch   = fusion_asin(sinp);
+    p_tilt->heading = fusion_atan2(2.0f * (q.w*q.z + q.x*q.y), 
+                                   1.0f - 2.0f * (q.y*q.y + q.z*q.z));
+
+    p_tilt->roll    *= SENSORS_RADS_TO_DPS;
+    p_tilt->pitch   *= SENSORS_RADS_TO_DPS;
+    p_tilt->heading *= SENSORS_RADS_TO_DPS;
+}
+
+// derive what the filter left out, runs on the reader side so the sensor 
+// task never pays for the trig
+inline void completeAttitude(sAttitude_t* p_att)
+{
+    sensors_vec_t tilt;
+
+    if (ATT_QUAT & p_att->valid)
+    {
+        if ((ATT_TILT | ATT_HEADING) != 
+            ((ATT_TILT | ATT_HEADING) & p_att->valid))
+        {
+            toTilt(&p_att->quat, &tilt);
+        }
+        if (!(ATT_TILT & p_att->valid))
+        {
+            p_att->tilt.roll  = tilt.roll;
+            p_att->tilt.pitch = tilt.pitch;
+        }
+        if (!(ATT_HEADING & p_att->valid))
+        {
+            p_att->tilt.heading = tilt.heading;
+        }
+    }
+    else if (ATT_TILT & p_att->valid)
+    {
+        // a filter without heading is taken as pointing north
+        if (!(ATT_HEADING & p_att->valid))
+        {
+            p_att->tilt.heading = 0;
+        }
+        toQuat(&p_att->tilt, &p_att->quat);
+    }
+    else
+    {
+        return;
+    }
+    p_att->valid = ATT_TILT | ATT_HEADING | ATT_QUAT;
+}
+
+#endif /* FUSION_TYPES_H_ */
@@ -0,0 +1,218 @@
+#ifndef MATRIX_H_
+#define MATRIX_H_
+
+#include <stdint.h>
+#include <cmath>
+
+// Fixed size matrix, dimensions are template parameters so every loop has
+// a compile time trip count, the compiler unrolls the small ones and no
+// heap is ever touched.
+template<uint8_t R, uint8_t C, typename T = float>
+class Matrix {
+public:
+    Matrix() 
+    {
+        fill(T(0));
+    }
+
+    static Matrix identity()
+    {
+        Matrix m;
+
+        for (uint8_t i = 0; (i < R) && (i < C); i++)
+        {
+            m(i, i) = T(1);
+        }
+        return m;
+    }
+
+    void fill(T val)
+    {
+        for (uint8_t i = 0; i < R; i++)
+        {
+            for (uint8_t j = 0; j < C; j++)
+            {
+                mData[i][j] = val;
+            }
+        }
+    }
+
+    T& operator()(uint8_t r, uint8_t c)
+    {
+        return mData[r][c];
+    }
+
+    const T& operator()(uint8_t r, uint8_t c) const
+    {
+        return mData[r][c];
+    }
+
+    Matrix<C, R, T> transpose() const
+    {
+        Matrix<C, R, T> t;
+
+        for (uint8_t i = 0; i < R; i++)
+        {
+            for (uint8_t j = 0; j < C; j++)
+            {
+                t(j, i) = mData[i][j];
+            }
+        }
+        return t;
+    }
+
+    template<uint8_t K>
+    Matrix<R, K, T> operator*(const Matrix<C, K, T>& b) const
+    {
+        Matrix<R, K, T> p;
+        T sum;
+
+        for (uint8_t i = 0; i < R; i++)
+        {
+            for (uint8_t k = 0; k < K; k++)
+            {
+                sum = T(0);
+                for (uint8_t j = 0; j < C; j++)
+                {
+                    sum += mData[i][j] * b(j, k);
+                }
+                p(i, k) = sum;
+            }
+        }
+        return p;
+    }
+
+    Matrix operator*(T s) const
+    {
+        Matrix p;
+
+        for (uint8_t i = 0; i < R; i++)
+        {
+            for (uint8_t j = 0; j < C; j++)
+            {
+                p(i, j) = mData[i][j] * s;
+            }
+        }
+        return p;
+    }
+
+    Matrix operator+(const Matrix& b) const
+    {
+        Matrix p;
+
+        for (uint8_t i = 0; i < R; i++)
+        {
+            for (uint8_t j = 0; j < C; j++)
+            {
+                p(i, j) = mData[i][j] + b(i, j);
+            }
+        }
+        return p;
+    }
+
+    Matrix operator-(const Matrix& b) const
+    {
+        Matrix p;
+
+        for (uint8_t i = 0; i < R; i++)
+        {
+            for (uint8_t j = 0; j < C; j++)
+            {
+                p(i, j) = mData[i][j] - b(i, j);
+            }
+        }
+        return p;
+    }
+
+private:
+    T mData[R][C];
+};
+
+// closed form 3x3 inverse, false when singular
+template<typename T>
+bool invert(const Matrix<3, 3, T>& a, Matrix<3, 3, T>* p_inv)
+{
+    Matrix<3, 3, T>& r = *p_inv;
+    T det;
+
+    r(0, 0) =   a(1, 1)*a(2, 2) - a(1, 2)*a(2, 1);
+    r(0, 1) = -(a(0, 1)*a(2, 2) - a(0, 2)*a(2, 1));
+    r(0, 2) =   a(0, 1)*a(1, 2) - a(0, 2)*a(1, 1);
+    r(1, 0) = -(a(1, 0)*a(2, 2) - a(1, 2)*a(2, 0));
+    r(1, 1) =   a(0, 0)*a(2, 2) - a(0, 2)*a(2, 0);
+    r(1, 2) = -(a(0, 0)*a(1, 2) - a(0, 2)*a(1, 0));
+    r(2, 0) =   a(1, 0)*a(2, 1) - a(1, 1)*a(2, 0);
+    r(2, 1) = -(a(0, 0)*a(2, 1) - a(0, 1)*a(2, 0));
+    r(2, 2) =   a(0, 0)*a(1, 1) - a(0, 1)*a(1, 0);
+
+    det = a(0, 0)*r(0, 0) + a(0, 1)*r(1, 0) + a(0, 2)*r(2, 0);
+    if (T(0) == det)
+    {
+        return false;
+    }
+
+    r = r * (T(1) / det);
+    return true;
+}
+
+// symmetric 3x3 eigen decomposition, cyclic Jacobi: a = vec * diag(val) * vec'
+template<typename T>
+void eigenSym(const Matrix<3, 3, T>& a, Matrix<3, 3, T>* p_vec, T val[3])
+{
+    using std::sqrt;
+    using std::fabs;
+    Matrix<3, 3, T> d = a;
+    Matrix<3, 3, T>& v = *p_vec;
+    T theta, t, c, s, tmp;
+
+    v = Matrix<3, 3, T>::identity();
+    for (uint8_t sweep = 0; sweep < 8; sweep++)
+    {
+        for (uint8_t p = 0; p < 2; p++)
+        {
+            for (uint8_t q = p + 1; q < 3; q++)
+            {
+                if (T(0) == d(p, q))
+                {
+                    continue;
+                }
+
+                // rotation which zeroes d(p, q)
+                theta = (d(q, q) - d(p, p)) / (T(2) * d(p, q));
+                t = T(1) / (fabs(theta) + sqrt(theta*theta + T(1)));
+                if (T(0) > theta)
+                {
+                    t = -t;
+                }
+                c = T(1) / sqrt(t*t + T(1));
+                s = t * c;
+
+                for (uint8_t k = 0; k < 3; k++)
+                {
+                    tmp = d(k, p);
+                    d(k, p) = c*tmp - s*d(k, q);
+                    d(k, q) = s*tmp + c*d(k, q);
+                }
+                for (uint8_t k = 0; k < 3; k++)
+                {
+                    tmp = d(p, k);
+                    d(p, k) = c*tmp - s*d(q, k);
+                    d(q, k) = s*tmp + c*d(q, k);
+                }
+                for (uint8_t k = 0; k < 3; k++)
+                {
+                    tmp = v(k, p);
+                    v(k, p) = c*tmp - s*v(k, q);
+                    v(k, q) = s*tmp + c*v(k, q);
+                }
+            }
+        }
+    }
+
+    for (uint8_t k = 0; k < 3; k++)
+    {
+        val[k] = d(k, k);
+    }
+}
+
+#endif /* MATRIX_H_ */
@@ -0,0 +1,118 @@
+#include "JSONWriter.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+/* private macros ------------------------------------------------------------*/
+#define FIXED_MAX       1.0e7   // below it hundredths fit a uint32_t
+
+JSONWriter::JSONWriter(char* p_buf, uint32_t len)
+    : mBuf{p_buf}
+    , mLen{len}
+    , mPos{0}
+    , mFull{false}
+{
+    put("{", 1);
+}
+
+JSONWriter::~JSONWriter()
+{
+}
+
+void JSONWriter::add(const char* key, float val)
+{
+    char num[JSON_FIXED_LEN];
+    uint32_t len;
+
+    len = fmtFixed2(num, val);
+
+    put((1 == mPos) ? "\"" : ",\"", (1 == mPos) ? 1 : 2);
+    put(key, strlen(key));
+    put("\":\"", 3);
+    put(num, len);
+    put("\"", 1);
+}
+
+uint32_t JSONWriter::finish()
+{
+    put("}", 1);
+    if (mFull)
+    {
+        // half an object is no use to a reader
+        if (0 < mLen)
+        {
+            mBuf[0] = '\0';
+        }
+        return 0;
+    }
+
+    mBuf[mPos] = '\0';
+    return mPos;
+}
+
+uint32_t JSONWriter::fmtFixed2(char* p_out, float val)
+{
+    char digits[10];
+    double scaled;
+    double whole;
+    uint32_t hundredths;
+    uint32_t pos = 0;
+    uint8_t u8_n = 0;
+
+    if (isnan(val))
+    {
+        memcpy(p_out, "nan", 4);
+        return 3;
+    }
+    if (!(FIXED_MAX > fabsf(val)))
+    {
+        // rare, inf included, leave it to printf
+        return snprintf(p_out, JSON_FIXED_LEN, "%.2f", val);
+    }
+
+    // float * 100 is exact in a double, so ties are real ties and round 
+    // to even like printf does
+    scaled = fabs((double)val) * 100.0;
+    whole = floor(scaled);
+    hundredths = (uint32_t)whole;
+    if (((scaled - whole) > 0.5) || 
+        (((scaled - whole) == 0.5) && (hundredths & 1)))
+    {
+        hundredths++;
+    }
+
+    if (signbit(val))
+    {
+        p_out[pos++] = '-';
+    }
+
+    // reversed digits, at least one before the point
+    do
+    {
+        digits[u8_n++] = '0' + (hundredths % 10);
+        hundredths /= 10;
+    } while ((0 < hundredths) || (3 > u8_n));
+
+    while (2 < u8_n)
+    {
+        p_out[pos++] = digits[--u8_n];
+    }
+    p_out[pos++] = '.';
+    p_out[pos++] = digits[1];
+    p_out[pos++] = digits[0];
+    p_out[pos] = '\0';
+    return pos;
+}
+
+void JSONWriter::put(const char* p_str, uint32_t len)
+{
+    // keep room for the nul, the rest is dropped once full
+    if (mFull || ((mPos + len) >= mLen))
+    {
+        mFull = true;
+        return;
+    }
+
+    memcpy(mBuf + mPos, p_str, len);
+    mPos += len;
+}
@@ -0,0 +1,34 @@
+#ifndef JSON_WRITER_H_
+#define JSON_WRITER_H_
+
+#include <stdint.h>
+
+#define JSON_FIXED_LEN  48      // FLT_MAX with two decimals, sign and nul
+
+// Flat JSON object built in place in a caller buffer, no heap. Values are
+// strings with two decimals, same text String(float) gives, so readers of
+// the old JSONVar reports see no difference.
+class JSONWriter {
+public:
+    JSONWriter(char* p_buf, uint32_t len);
+    ~JSONWriter();
+
+    // "key":"12.34"
+    void add(const char* key, float val);
+
+    // closes the object, length without nul or 0 if it did not fit
+    uint32_t finish();
+
+    // %.2f without printf, returns length, p_out holds JSON_FIXED_LEN
+    static uint32_t fmtFixed2(char* p_out, float val);
+
+private:
+    char* mBuf;
+    uint32_t mLen;
+    uint32_t mPos;
+    bool mFull;
+
+    void put(const char* p_str, uint32_t len);
+};
+
+#endif /* JSON_WRITER_H_ */
@@ -1,5 +1,7 @@
 #include "SensorLogger.h"
 
+#ifdef ARDUINO
+
 SensorLogger::SensorLogger(HardwareSerial& serial, TwoWire& wire) 
     : mOled{128, 32, &wire}
     , mSerial{serial}
@@ -52,4 +54,38 @@ void SensorLogger::report(String ip, uint16_t port, sensors_vec_t* p_tilt)
     mSerial.printf("%f %f %f\n",    2 * p_tilt->roll    , 
                                     2 * p_tilt->pitch   , 
                                     2 * p_tilt->heading );
-}
\ No newline at end of file
+}
+
+#else
+
+SensorLogger::SensorLogger(FILE* stream) 
+    : mStream{stream}
+{
+}
+
+SensorLogger::~SensorLogger()
+{
+}
+
+void SensorLogger::init(uint32_t baud, const char* msg)
+{
+    // no serial nor oled on host, baud is ignored
+    (void)baud;
+    write(msg);
+}
+
+void SensorLogger::write(const char* msg)
+{
+    fputs(msg, mStream);
+    fflush(mStream);
+}
+
+void SensorLogger::report(sensors_vec_t* p_tilt)
+{
+    fprintf(mStream, "Orientation: ");
+    fprintf(mStream, "%f %f %f\n",  p_tilt->roll    , 
+                                    p_tilt->pitch   , 
+                                    p_tilt->heading );
+}
+
+#endif
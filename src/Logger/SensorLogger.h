@@ -1,21 +1,37 @@
 #ifndef SENSOR_LOGGER_H_
 #define SENSOR_LOGGER_H_
 
-#include <Adafruit_SSD1306.h>
 #include <Adafruit_Sensor.h>
+#ifdef ARDUINO
+#include <Adafruit_SSD1306.h>
+#else
+#include <cstdio>
+#endif
 
 class SensorLogger {
 public:
+#ifdef ARDUINO
     SensorLogger(HardwareSerial& serial, TwoWire& wire);
+#else
+    SensorLogger(FILE* stream);
+#endif
     ~SensorLogger();
 
     void init(uint32_t baud, const char* msg);
     void write(const char *msg);
+#ifdef ARDUINO
     void report(String ip, uint16_t port, sensors_vec_t* p_tilt);
+#else
+    void report(sensors_vec_t* p_tilt);
+#endif
 
 private:
+#ifdef ARDUINO
     Adafruit_SSD1306 mOled;
     HardwareSerial& mSerial;
+#else
+    FILE* mStream;
+#endif
 };
 
-#endif /* SENSOR_LOGGER_H_ */
\ No newline at end of file
+#endif /* SENSOR_LOGGER_H_ */
@@ -0,0 +1,110 @@
+#ifndef LATENCY_HIST_H_
+#define LATENCY_HIST_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#define HIST_BUCKETS    64
+
+// Constant memory latency histogram in us, log linear buckets: exact up to 
+// 3 us, then 4 buckets per octave (<= 25% wide) up to ~130 ms. Quantiles 
+// report the bucket upper bound. Single writer, readers may see a sample 
+// in count but not yet in its bucket.
+class LatencyHist {
+public:
+    LatencyHist()
+    {
+        reset();
+    }
+
+    void reset()
+    {
+        memset(mBucket, 0x0, sizeof(mBucket));
+        mCount = 0;
+        mMax = 0;
+    }
+
+    void add(uint32_t us)
+    {
+        mBucket[index(us)]++;
+        mCount++;
+        if (us > mMax)
+        {
+            mMax = us;
+        }
+    }
+
+    // q in [0, 1], 0 while empty
+    uint32_t quantile(float q) const
+    {
+        uint32_t rank;
+        uint32_t sum = 0;
+
+        if (0 == mCount)
+        {
+            return 0;
+        }
+
+        rank = (uint32_t)(q * (float)mCount);
+        if (rank >= mCount)
+        {
+            rank = mCount - 1;
+        }
+        for (uint8_t u8_k = 0; u8_k < HIST_BUCKETS; u8_k++)
+        {
+            sum += mBucket[u8_k];
+            if (sum > rank)
+            {
+                return (upper(u8_k) < mMax) ? upper(u8_k) : mMax;
+            }
+        }
+        return mMax;
+    }
+
+    uint32_t getCount() const
+    {
+        return mCount;
+    }
+
+    uint32_t getMax() const
+    {
+        return mMax;
+    }
+
+private:
+    uint32_t mBucket[HIST_BUCKETS];
+    uint32_t mCount;
+    uint32_t mMax;
+
+    static uint8_t index(uint32_t us)
+    {
+        uint8_t msb;
+        uint32_t idx;
+
+        if (us < 4)
+        {
+            return us;
+        }
+
+        // octave from the top bit, sub bucket from the next two
+        msb = 31 - __builtin_clz(us);
+        idx = (msb - 1) * 4 + ((us >> (msb - 2)) & 3);
+
+        return (idx < HIST_BUCKETS) ? idx : (HIST_BUCKETS - 1);
+    }
+
+    static uint32_t upper(uint8_t idx)
+    {
+        uint8_t msb;
+
+        if (idx < 4)
+        {
+            return idx;
+        }
+
+        msb = idx / 4 + 1;
+        return ((4u + (idx & 3)) << (msb - 2)) + (1u << (msb - 2)) - 1;
+    }
+};
+
+#endif /* LATENCY_HIST_H_ */
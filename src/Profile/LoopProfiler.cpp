@@ -0,0 +1,73 @@
+#include "LoopProfiler.h"
+#include <stdio.h>
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <chrono>
+#endif
+
+/* private variables ---------------------------------------------------------*/
+static const char* const stageName[PROF_STAGES] = {
+    "step", "wait", "magn", "imu", "update", "json", "logger", "server"
+};
+
+LoopProfiler::LoopProfiler()
+{
+#ifdef ARDUINO
+    mCyclesPerUs = getCpuFrequencyMhz();
+#else
+    // host counts nanoseconds
+    mCyclesPerUs = 1000;
+#endif
+}
+
+LoopProfiler& LoopProfiler::get()
+{
+    static LoopProfiler profiler;
+
+    return profiler;
+}
+
+uint32_t LoopProfiler::cycles()
+{
+#ifdef ARDUINO
+    return ESP.getCycleCount();
+#else
+    return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+void LoopProfiler::add(eProfStage_t stage, uint32_t cycles)
+{
+    mHist[stage].add(cycles / mCyclesPerUs);
+}
+
+const LatencyHist& LoopProfiler::getHist(eProfStage_t stage) const
+{
+    return mHist[stage];
+}
+
+uint32_t LoopProfiler::toJSON(char* p_buf, uint32_t len) const
+{
+    uint32_t pos;
+
+    // snprintf returns the untruncated length, stop once the buffer is full
+    pos = snprintf(p_buf, len, "{");
+    for (uint8_t u8_k = 0; (u8_k < PROF_STAGES) && (pos < len); u8_k++)
+    {
+        pos += snprintf(p_buf + pos, len - pos, 
+                        "%s\"%s\":{\"n\":%u,\"p50\":%u,\"p99\":%u,\"max\":%u}",
+                        (0 == u8_k) ? "" : ",", stageName[u8_k],
+                        (unsigned)mHist[u8_k].getCount(),
+                        (unsigned)mHist[u8_k].quantile(0.50),
+                        (unsigned)mHist[u8_k].quantile(0.99),
+                        (unsigned)mHist[u8_k].getMax());
+    }
+    if (pos < len)
+    {
+        pos += snprintf(p_buf + pos, len - pos, "}");
+    }
+
+    return (pos < len) ? pos : (len - 1);
+}
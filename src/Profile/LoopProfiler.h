@@ -0,0 +1,67 @@
+#ifndef LOOP_PROFILER_H_
+#define LOOP_PROFILER_H_
+
+#include <stdint.h>
+#include "LatencyHist.h"
+
+typedef enum {
+    PROF_STEP,          // whole pipeline step, i.e. sample period
+    PROF_WAIT,          // mpu.wait
+    PROF_MAGN,          // hmc.getEvent
+    PROF_IMU,           // mpu.getEvent
+    PROF_UPDATE,        // filter update
+    PROF_JSON,          // getReport
+    PROF_LOGGER,        // logger.report
+    PROF_SERVER,        // server.report
+    PROF_STAGES
+} eProfStage_t;
+
+// Per stage latency histograms fed from cycle counter deltas. Each stage 
+// must only be timed from one task, any task may read.
+class LoopProfiler {
+public:
+    static LoopProfiler& get();
+
+    void add(eProfStage_t stage, uint32_t cycles);
+    const LatencyHist& getHist(eProfStage_t stage) const;
+
+    // {"wait":{"n":..,"p50":..,"p99":..,"max":..},...} in us, returns length
+    uint32_t toJSON(char* p_buf, uint32_t len) const;
+
+    static uint32_t cycles();
+
+private:
+    LoopProfiler();
+
+    LatencyHist mHist[PROF_STAGES];
+    uint32_t mCyclesPerUs;
+};
+
+// times the enclosing block
+class ProfScope {
+public:
+    ProfScope(eProfStage_t stage) 
+        : mStage{stage}
+        , mStart{LoopProfiler::cycles()} 
+    {
+    }
+
+    ~ProfScope()
+    {
+        LoopProfiler::get().add(mStage, LoopProfiler::cycles() - mStart);
+    }
+
+private:
+    eProfStage_t mStage;
+    uint32_t mStart;
+};
+
+#ifdef USE_PROFILE
+#define PROF_CAT_(a, b)     a##b
+#define PROF_CAT(a, b)      PROF_CAT_(a, b)
+#define PROF_SCOPE(stage)   ProfScope PROF_CAT(prof_, __LINE__)(stage)
+#else
+#define PROF_SCOPE(stage)
+#endif
+
+#endif /* LOOP_PROFILER_H_ */
@@ -0,0 +1,41 @@
+#ifndef ATTITUDE_SNAPSHOT_H_
+#define ATTITUDE_SNAPSHOT_H_
+
+#include "Sensor/SensorTypes.h"
+#include "Seqlock.h"
+
+// Latest fused sample for any task (server handlers, logger, reporter), 
+// published by the sensor task without taking a lock
+class AttitudeSnapshot {
+public:
+    AttitudeSnapshot() : mRetries{0} {};
+
+    void publish(const sAttitude_t* p_sample)
+    {
+        mLock.write(*p_sample);
+    }
+
+    // false until the first publish
+    bool read(sAttitude_t* p_sample)
+    {
+        if (0 == mLock.getSeq())
+        {
+            return false;
+        }
+
+        mRetries += mLock.read(p_sample);
+        return true;
+    }
+
+    // readers which raced the writer, for diagnostics only
+    uint32_t getRetries() const
+    {
+        return mRetries;
+    }
+
+private:
+    Seqlock<sAttitude_t> mLock;
+    std::atomic<uint32_t> mRetries;
+};
+
+#endif /* ATTITUDE_SNAPSHOT_H_ */
@@ -0,0 +1,18 @@
+#ifndef CLOCK_H_
+#define CLOCK_H_
+
+#include <stdint.h>
+
+// Time source of the schedulers, microseconds wrapping at 2^32 (~71 min),
+// compare with signed differences only
+class Clock {
+public:
+    virtual ~Clock() {};
+
+    virtual uint32_t now() = 0;
+
+    // return once now() reached t_us, may return at once if already past
+    virtual void sleepUntil(uint32_t t_us) = 0;
+};
+
+#endif /* CLOCK_H_ */
@@ -0,0 +1,36 @@
+#ifdef ARDUINO
+#include "ClockArduino.h"
+
+/* private macros ------------------------------------------------------------*/
+#define SPIN_US     (1000 * portTICK_PERIOD_MS)
+
+ClockArduino::ClockArduino()
+{
+}
+
+ClockArduino::~ClockArduino()
+{
+}
+
+uint32_t ClockArduino::now()
+{
+    return micros();
+}
+
+void ClockArduino::sleepUntil(uint32_t t_us)
+{
+    int32_t left_us;
+
+    // give the cpu away for whole ticks, tick edges are not aligned to us
+    left_us = (int32_t)(t_us - micros());
+    if (left_us > 2 * SPIN_US)
+    {
+        vTaskDelay((left_us - SPIN_US) / SPIN_US);
+    }
+
+    while (0 < (int32_t)(t_us - micros()))
+    {
+        // wait blocking
+    }
+}
+#endif
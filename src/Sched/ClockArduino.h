@@ -0,0 +1,17 @@
+#ifndef CLOCK_ARDUINO_H_
+#define CLOCK_ARDUINO_H_
+
+#include <Arduino.h>
+#include "Clock.h"
+
+// micros() based clock, sleeps in RTOS ticks and spins the last tick
+class ClockArduino : public Clock {
+public:
+    ClockArduino();
+    ~ClockArduino();
+
+    uint32_t now() override;
+    void sleepUntil(uint32_t t_us) override;
+};
+
+#endif /* CLOCK_ARDUINO_H_ */
@@ -0,0 +1,35 @@
+#ifndef CLOCK_SIM_H_
+#define CLOCK_SIM_H_
+
+#include "Clock.h"
+
+// Virtual time for host runs, only moves on sleepUntil() or advance()
+class ClockSim : public Clock {
+public:
+    ClockSim(uint32_t start_us = 0) : mNow_us{start_us} {};
+    ~ClockSim() {};
+
+    uint32_t now() override
+    {
+        return mNow_us;
+    }
+
+    void sleepUntil(uint32_t t_us) override
+    {
+        if (0 < (int32_t)(t_us - mNow_us))
+        {
+            mNow_us = t_us;
+        }
+    }
+
+    // time spent working between two waits
+    void advance(uint32_t us)
+    {
+        mNow_us += us;
+    }
+
+private:
+    uint32_t mNow_us;
+};
+
+#endif /* CLOCK_SIM_H_ */
@@ -0,0 +1,76 @@
+#include "RateScheduler.h"
+
+RateScheduler::RateScheduler(Clock& clock, uint32_t period_us, 
+                             eSchedPolicy_t policy)
+    : mClock{clock}
+    , mPeriod_us{period_us}
+    , mPolicy{policy}
+    , mNext_us{0}
+    , mLast_us{0}
+    , mDt{0.0}
+    , mOverruns{0}
+    , mSkipped{0}
+{
+}
+
+RateScheduler::~RateScheduler()
+{
+}
+
+void RateScheduler::begin()
+{
+    mLast_us = mClock.now();
+    mNext_us = mLast_us + mPeriod_us;
+    mDt = 1e-6 * (float)mPeriod_us;
+    mOverruns = 0;
+    mSkipped = 0;
+}
+
+float RateScheduler::wait()
+{
+    int32_t late_us;
+    uint32_t slots;
+
+    late_us = (int32_t)(mClock.now() - mNext_us);
+    if (late_us <= 0)
+    {
+        mClock.sleepUntil(mNext_us);
+    }
+    else
+    {
+        mOverruns++;
+
+        // missed whole slots, deadline of this step is already gone
+        slots = (uint32_t)late_us / mPeriod_us;
+        if ((SCHED_CATCHUP == mPolicy) && (slots > SCHED_CATCHUP_MAX))
+        {
+            slots = slots - SCHED_CATCHUP_MAX;
+            mSkipped += slots;
+            mNext_us += slots * mPeriod_us;
+        }
+        else if (SCHED_SKIP == mPolicy)
+        {
+            mSkipped += slots;
+            mNext_us += slots * mPeriod_us;
+        }
+        else if (SCHED_RESYNC == mPolicy)
+        {
+            mSkipped += slots;
+            mNext_us = mClock.now();
+        }
+    }
+    mNext_us += mPeriod_us;
+
+    return mark();
+}
+
+float RateScheduler::mark()
+{
+    uint32_t now_us;
+
+    now_us = mClock.now();
+    mDt = 1e-6 * (float)(uint32_t)(now_us - mLast_us);
+    mLast_us = now_us;
+
+    return mDt;
+}
@@ -0,0 +1,63 @@
+#ifndef RATE_SCHEDULER_H_
+#define RATE_SCHEDULER_H_
+
+#include <stdint.h>
+#include "Clock.h"
+
+// what to do once a step ran past a whole period
+typedef enum {
+    SCHED_SKIP,         // drop missed slots, stay on the original grid
+    SCHED_CATCHUP,      // run missed slots back to back, up to SCHED_CATCHUP_MAX
+    SCHED_RESYNC        // restart the grid from now
+} eSchedPolicy_t;
+
+#define SCHED_CATCHUP_MAX   4
+
+// Fixed rate loop on absolute deadlines (next = prev + period), so step 
+// duration and wake up latency do not add up to drift. The dt between 
+// two wake ups is measured for the filters.
+class RateScheduler {
+public:
+    RateScheduler(Clock& clock, uint32_t period_us, 
+                  eSchedPolicy_t policy = SCHED_SKIP);
+    ~RateScheduler();
+
+    void begin();
+
+    // sleep until the next deadline, returns measured dt [s]
+    float wait();
+
+    // externally paced step (e.g. data ready), only measures dt [s]
+    float mark();
+
+    float getDt() const
+    {
+        return mDt;
+    }
+
+    // steps which started after their deadline
+    uint32_t getOverruns() const
+    {
+        return mOverruns;
+    }
+
+    // slots dropped by SCHED_SKIP / SCHED_RESYNC
+    uint32_t getSkipped() const
+    {
+        return mSkipped;
+    }
+
+private:
+    Clock& mClock;
+    uint32_t mPeriod_us;
+    eSchedPolicy_t mPolicy;
+
+    uint32_t mNext_us;
+    uint32_t mLast_us;
+    float mDt;
+
+    uint32_t mOverruns;
+    uint32_t mSkipped;
+};
+
+#endif /* RATE_SCHEDULER_H_ */
@@ -0,0 +1,46 @@
+#ifndef RING_SINK_H_
+#define RING_SINK_H_
+
+#include "Sensor/SensorTypes.h"
+#include "Clock.h"
+#include "SpscRing.h"
+#include "AttitudeSnapshot.h"
+
+// FusionPipeline sink which only stamps every sample into a ring and the 
+// optional snapshot, the slow reporting work and the attitude conversions
+// (completeAttitude) are left to the readers
+template<uint32_t N>
+class RingSink {
+public:
+    typedef SpscRing<sAttitude_t, N> ring_t;
+
+    RingSink(Clock& clock, ring_t& ring, AttitudeSnapshot* p_snap = nullptr)
+        : mClock{clock}
+        , mRing{ring}
+        , mSnap{p_snap}
+    {
+    }
+
+    bool due()
+    {
+        return true;
+    }
+
+    void report(sAttitude_t* p_sample)
+    {
+        p_sample->t_us = mClock.now();
+
+        mRing.push(*p_sample);
+        if (nullptr != mSnap)
+        {
+            mSnap->publish(p_sample);
+        }
+    }
+
+private:
+    Clock& mClock;
+    ring_t& mRing;
+    AttitudeSnapshot* mSnap;
+};
+
+#endif /* RING_SINK_H_ */
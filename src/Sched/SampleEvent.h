@@ -0,0 +1,18 @@
+#ifndef SAMPLE_EVENT_H_
+#define SAMPLE_EVENT_H_
+
+#include <stdint.h>
+
+// "Sample ready" notification, lets the sensor task sleep until the chip 
+// has data instead of spinning on the bus or the clock
+class SampleEvent {
+public:
+    virtual ~SampleEvent() {};
+
+    virtual void begin() = 0;
+
+    // block until the next sample is ready, false on timeout
+    virtual bool wait(uint32_t timeout_ms) = 0;
+};
+
+#endif /* SAMPLE_EVENT_H_ */
@@ -0,0 +1,47 @@
+#ifdef ARDUINO
+#include "SampleEventISR.h"
+
+SampleEventISR::SampleEventISR(uint8_t pin, int mode)
+    : mPin{pin}
+    , mMode{mode}
+    , mTask{nullptr}
+{
+}
+
+SampleEventISR::~SampleEventISR()
+{
+    detachInterrupt(mPin);
+}
+
+void SampleEventISR::begin()
+{
+    mTask = xTaskGetCurrentTaskHandle();
+
+    // enable Arduino interrupt detection
+    pinMode(mPin, INPUT);
+    attachInterruptArg(mPin, isr, this, mMode);
+}
+
+bool SampleEventISR::wait(uint32_t timeout_ms)
+{
+    // whoever waits gets the notification
+    mTask = xTaskGetCurrentTaskHandle();
+
+    return (0 < ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeout_ms)));
+}
+
+void IRAM_ATTR SampleEventISR::isr(void* arg)
+{
+    SampleEventISR* self = (SampleEventISR*) arg;
+    BaseType_t woken = pdFALSE;
+
+    if (nullptr != self->mTask)
+    {
+        vTaskNotifyGiveFromISR(self->mTask, &woken);
+    }
+    if (pdFALSE != woken)
+    {
+        portYIELD_FROM_ISR();
+    }
+}
+#endif
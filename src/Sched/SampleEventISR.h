@@ -0,0 +1,26 @@
+#ifndef SAMPLE_EVENT_ISR_H_
+#define SAMPLE_EVENT_ISR_H_
+
+#include <Arduino.h>
+#include "SampleEvent.h"
+
+// Data ready pin of the MPU6050, edge interrupt wakes the waiting task 
+// through a FreeRTOS task notification
+class SampleEventISR : public SampleEvent {
+public:
+    SampleEventISR(uint8_t pin, int mode);
+    ~SampleEventISR();
+
+    void begin() override;
+    bool wait(uint32_t timeout_ms) override;
+
+private:
+    uint8_t mPin;
+    int mMode;
+
+    volatile TaskHandle_t mTask;
+
+    static void IRAM_ATTR isr(void* arg);
+};
+
+#endif /* SAMPLE_EVENT_ISR_H_ */
@@ -0,0 +1,45 @@
+#include "SampleEventSim.h"
+#include <chrono>
+
+SampleEventSim::SampleEventSim()
+    : mPending{0}
+    , mMissed{0}
+{
+}
+
+SampleEventSim::~SampleEventSim()
+{
+}
+
+void SampleEventSim::begin()
+{
+    std::lock_guard<std::mutex> guard(mLock);
+
+    mPending = 0;
+    mMissed = 0;
+}
+
+bool SampleEventSim::wait(uint32_t timeout_ms)
+{
+    std::unique_lock<std::mutex> guard(mLock);
+
+    if (!mCond.wait_for(guard, std::chrono::milliseconds(timeout_ms), 
+                        [this] { return 0 < mPending; }))
+    {
+        return false;
+    }
+
+    // more than one edge since last wait means samples were overwritten
+    mMissed += mPending - 1;
+    mPending = 0;
+    return true;
+}
+
+void SampleEventSim::fire()
+{
+    {
+        std::lock_guard<std::mutex> guard(mLock);
+        mPending++;
+    }
+    mCond.notify_one();
+}
@@ -0,0 +1,34 @@
+#ifndef SAMPLE_EVENT_SIM_H_
+#define SAMPLE_EVENT_SIM_H_
+
+#include "SampleEvent.h"
+#include <mutex>
+#include <condition_variable>
+
+// Host stand in for the data ready interrupt, fire() plays the ISR and may 
+// be called from any thread. Pending events count up like a task 
+// notification and wait() takes them all at once.
+class SampleEventSim : public SampleEvent {
+public:
+    SampleEventSim();
+    ~SampleEventSim();
+
+    void begin() override;
+    bool wait(uint32_t timeout_ms) override;
+
+    void fire();
+
+    uint32_t getMissed() const
+    {
+        return mMissed;
+    }
+
+private:
+    std::mutex mLock;
+    std::condition_variable mCond;
+
+    uint32_t mPending;
+    uint32_t mMissed;
+};
+
+#endif /* SAMPLE_EVENT_SIM_H_ */
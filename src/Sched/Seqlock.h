@@ -0,0 +1,67 @@
+#ifndef SEQLOCK_H_
+#define SEQLOCK_H_
+
+#include <stdint.h>
+#include <atomic>
+
+// Single writer sequence lock. The counter is odd while a write is in 
+// progress, readers copy the value and retry when the counter was odd or 
+// moved meanwhile. Writer never waits, T must be trivially copyable.
+template<typename T>
+class Seqlock {
+public:
+    Seqlock() : mSeq{0} {};
+
+    void write(const T& value)
+    {
+        uint32_t seq = mSeq.load(std::memory_order_relaxed);
+
+        mSeq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        mValue = value;
+
+        mSeq.store(seq + 2, std::memory_order_release);
+    }
+
+    // single attempt, false on a torn copy
+    bool tryRead(T* p_value) const
+    {
+        uint32_t seq;
+
+        seq = mSeq.load(std::memory_order_acquire);
+        if (seq & 1)
+        {
+            return false;
+        }
+
+        *p_value = mValue;
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return (seq == mSeq.load(std::memory_order_relaxed));
+    }
+
+    // spin until a consistent copy, returns the number of retries
+    uint32_t read(T* p_value) const
+    {
+        uint32_t retry = 0;
+
+        while (!tryRead(p_value))
+        {
+            retry++;
+        }
+        return retry;
+    }
+
+    // even count of completed writes times two
+    uint32_t getSeq() const
+    {
+        return mSeq.load(std::memory_order_acquire);
+    }
+
+private:
+    std::atomic<uint32_t> mSeq;
+    T mValue;
+};
+
+#endif /* SEQLOCK_H_ */
@@ -0,0 +1,87 @@
+#ifndef SPSC_RING_H_
+#define SPSC_RING_H_
+
+#include <stdint.h>
+#include <atomic>
+
+// Lock free single producer / single consumer ring. Each index is written 
+// by one side only, the release store publishes the slot to the other 
+// side. N must be a power of two, one slot stays free to tell full from 
+// empty. Producer never blocks, a full ring drops the new item.
+template<typename T, uint32_t N>
+class SpscRing {
+    static_assert((N >= 2) && (0 == (N & (N - 1))), "N power of two");
+
+public:
+    SpscRing() : mHead{0}, mTail{0}, mDropped{0} {};
+
+    // producer side
+    bool push(const T& item)
+    {
+        uint32_t head = mHead.load(std::memory_order_relaxed);
+        uint32_t next = (head + 1) & (N - 1);
+
+        if (next == mTail.load(std::memory_order_acquire))
+        {
+            mDropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        mBuf[head] = item;
+        mHead.store(next, std::memory_order_release);
+        return true;
+    }
+
+    // consumer side
+    bool pop(T* p_item)
+    {
+        uint32_t tail = mTail.load(std::memory_order_relaxed);
+
+        if (tail == mHead.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        *p_item = mBuf[tail];
+        mTail.store((tail + 1) & (N - 1), std::memory_order_release);
+        return true;
+    }
+
+    // consumer side, newest item only, older ones are dropped
+    bool popLatest(T* p_item)
+    {
+        uint32_t head = mHead.load(std::memory_order_acquire);
+        uint32_t tail = mTail.load(std::memory_order_relaxed);
+
+        if (tail == head)
+        {
+            return false;
+        }
+
+        *p_item = mBuf[(head - 1) & (N - 1)];
+        mTail.store(head, std::memory_order_release);
+        return true;
+    }
+
+    // approximate when called from the other side
+    uint32_t size() const
+    {
+        return (mHead.load(std::memory_order_acquire) - 
+                mTail.load(std::memory_order_acquire)) & (N - 1);
+    }
+
+    uint32_t getDropped() const
+    {
+        return mDropped.load(std::memory_order_relaxed);
+    }
+
+private:
+    // keep the indices apart, each one bounces between cores
+    alignas(64) std::atomic<uint32_t> mHead;
+    alignas(64) std::atomic<uint32_t> mTail;
+    std::atomic<uint32_t> mDropped;
+
+    T mBuf[N];
+};
+
+#endif /* SPSC_RING_H_ */
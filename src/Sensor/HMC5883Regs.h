@@ -0,0 +1,22 @@
+#ifndef HMC5883_REGS_H_
+#define HMC5883_REGS_H_
+
+// HMC5883L registers and raw scales for the I2CBus based drivers, same 
+// addresses as HMC5883_REGISTER_MAG_* in the Adafruit driver
+#define HMC_ADDR            0x1E
+#define HMC_CONFIG_A        0x00
+#define HMC_CONFIG_B        0x01
+#define HMC_MODE            0x02
+#define HMC_DATA_X_H        0x03
+#define HMC_ID_A            0x0A
+#define HMC_DATA_LEN        6       // X, Z, Y big endian
+
+#define HMC_RATE_75HZ       0x18
+#define HMC_GAIN_1_3GA      0x20
+#define HMC_CONTINUOUS      0x00
+
+// gain 1.3Ga, set by the drivers
+#define HMC_LSB_GAUSS_XY    1100.0
+#define HMC_LSB_GAUSS_Z     980.0
+
+#endif /* HMC5883_REGS_H_ */
@@ -0,0 +1,78 @@
+#include "HMCAsync.h"
+#include <cstring>
+
+HMCAsync::HMCAsync(I2CQueue& queue)
+    : mQueue{queue}
+    , mBusy{false}
+    , mOk{false}
+    , mPending{false}
+    , mValid{false}
+    , mErrors{0}
+{
+    memset(&mMagn, 0x0, sizeof(sensors_vec_t));
+}
+
+HMCAsync::~HMCAsync()
+{
+}
+
+void HMCAsync::begin()
+{
+    uint8_t id[3];
+
+    if (!mQueue.read(HMC_ADDR, HMC_ID_A, 3, id) || 
+        ('H' != id[0]) || ('4' != id[1]) || ('3' != id[2]))
+    {
+        throw ("HMC5883L error\n");
+    }
+
+    // same setup as the Adafruit driver: gain 1.3Ga, continuous mode
+    mQueue.writeByte(HMC_ADDR, HMC_CONFIG_B, HMC_GAIN_1_3GA);
+    mQueue.writeByte(HMC_ADDR, HMC_MODE, HMC_CONTINUOUS);
+}
+
+bool HMCAsync::read(sensors_vec_t* p_magn)
+{
+    sI2CXact_t xact = { HMC_ADDR, HMC_DATA_X_H, HMC_DATA_LEN, false, 
+                        mBuf, done, this };
+
+    // last transfer still on the bus, keep handing out the previous one
+    if (!mBusy.load(std::memory_order_acquire))
+    {
+        if (mPending && mOk)
+        {
+            // register order is X, Z, Y
+            mMagn.x = (int16_t)((mBuf[0] << 8) | mBuf[1]) * 
+                      (SENSORS_GAUSS_TO_MICROTESLA / HMC_LSB_GAUSS_XY);
+            mMagn.z = (int16_t)((mBuf[2] << 8) | mBuf[3]) * 
+                      (SENSORS_GAUSS_TO_MICROTESLA / HMC_LSB_GAUSS_Z);
+            mMagn.y = (int16_t)((mBuf[4] << 8) | mBuf[5]) * 
+                      (SENSORS_GAUSS_TO_MICROTESLA / HMC_LSB_GAUSS_XY);
+            mValid = true;
+        }
+        else if (mPending)
+        {
+            mErrors++;
+        }
+
+        // worker may finish before submit() returns
+        mBusy.store(true, std::memory_order_relaxed);
+        mPending = mQueue.submit(&xact);
+        if (!mPending)
+        {
+            mBusy.store(false, std::memory_order_relaxed);
+            mErrors++;
+        }
+    }
+
+    *p_magn = mMagn;
+    return mValid;
+}
+
+void HMCAsync::done(void* p_arg, bool ok)
+{
+    HMCAsync* p_hmc = (HMCAsync*)p_arg;
+
+    p_hmc->mOk = ok;
+    p_hmc->mBusy.store(false, std::memory_order_release);
+}
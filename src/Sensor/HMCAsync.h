@@ -0,0 +1,45 @@
+#ifndef HMC_ASYNC_H_
+#define HMC_ASYNC_H_
+
+#include "SensorTypes.h"
+#include "Bus/I2CQueue.h"
+#include "HMC5883Regs.h"
+#include <atomic>
+
+// HMC5883L read through the I2CQueue worker: read() hands out the newest 
+// completed sample and queues the next transfer, so the sensor task never 
+// waits on the magnetometer. The sample is one call old, the chip updates
+// slower than the loop runs anyway.
+class HMCAsync {
+public:
+    HMCAsync(I2CQueue& queue);
+    ~HMCAsync();
+
+    // blocking setup through the queue, throws on a missing magnetometer
+    void begin();
+
+    // Adafruit units (uT), false until a first transfer completed
+    bool read(sensors_vec_t* p_magn);
+
+    // transfers the worker failed or the queue refused
+    uint32_t getErrors() const
+    {
+        return mErrors;
+    }
+
+private:
+    I2CQueue& mQueue;
+
+    uint8_t mBuf[HMC_DATA_LEN];     // worker owned while mBusy
+    std::atomic<bool> mBusy;
+    bool mOk;                       // set by the worker before mBusy clears
+    bool mPending;
+
+    sensors_vec_t mMagn;
+    bool mValid;
+    uint32_t mErrors;
+
+    static void done(void* p_arg, bool ok);
+};
+
+#endif /* HMC_ASYNC_H_ */
@@ -0,0 +1,96 @@
+#include "MARGAux.h"
+#include "MPU6050Regs.h"
+#include "HMC5883Regs.h"
+
+/* private macros ------------------------------------------------------------*/
+#define MPU_MST_WAIT_ES     0x40    // data ready waits for slave data
+#define MPU_MST_400KHZ      13
+#define MPU_SLV_READ        0x80
+#define MPU_SLV_EN          0x80
+#define MPU_BYPASS_EN       0x02
+#define MPU_MST_EN          0x20
+#define MPU_BURST_LEN       20      // accel 6, temp 2, gyro 6, ext 6
+
+MARGAux::MARGAux(I2CBus& bus)
+    : mBus{bus}
+{
+}
+
+MARGAux::~MARGAux()
+{
+}
+
+void MARGAux::begin()
+{
+    uint8_t id[3];
+
+    // full scale the raw counts are converted with
+    setReg(MPU_ADDR, MPU_GYRO_CONFIG, 0x00);
+    setReg(MPU_ADDR, MPU_ACCEL_CONFIG, 0x00);
+
+    // reach the magnetometer directly to set it up
+    setReg(MPU_ADDR, MPU_USER_CTRL, 0x00);
+    setReg(MPU_ADDR, MPU_INT_PIN_CFG, MPU_BYPASS_EN);
+
+    if (!mBus.read(HMC_ADDR, HMC_ID_A, 3, id) || 
+        ('H' != id[0]) || ('4' != id[1]) || ('3' != id[2]))
+    {
+        throw ("HMC5883L error\n");
+    }
+    setReg(HMC_ADDR, HMC_CONFIG_A, HMC_RATE_75HZ);
+    setReg(HMC_ADDR, HMC_CONFIG_B, HMC_GAIN_1_3GA);
+    setReg(HMC_ADDR, HMC_MODE, HMC_CONTINUOUS);
+
+    // hand the aux bus to the MPU6050 master, slave 0 reads X,Z,Y
+    setReg(MPU_ADDR, MPU_INT_PIN_CFG, 0x00);
+    setReg(MPU_ADDR, MPU_I2C_MST_CTRL, MPU_MST_WAIT_ES | MPU_MST_400KHZ);
+    setReg(MPU_ADDR, MPU_I2C_SLV0_ADDR, MPU_SLV_READ | HMC_ADDR);
+    setReg(MPU_ADDR, MPU_I2C_SLV0_REG, HMC_DATA_X_H);
+    setReg(MPU_ADDR, MPU_I2C_SLV0_CTRL, MPU_SLV_EN | HMC_DATA_LEN);
+    setReg(MPU_ADDR, MPU_USER_CTRL, MPU_MST_EN);
+}
+
+void MARGAux::setReg(uint8_t dev, uint8_t reg, uint8_t data)
+{
+    // a half configured master returns garbage in EXT_SENS_DATA
+    if (!mBus.writeByte(dev, reg, data))
+    {
+        throw ((HMC_ADDR == dev) ? "HMC5883L error\n" : "MPU6050 error\n");
+    }
+}
+
+bool MARGAux::read(sMARGRaw_t* p_raw)
+{
+    uint8_t buf[MPU_BURST_LEN];
+
+    if (!mBus.read(MPU_ADDR, MPU_ACCEL_XOUT_H, MPU_BURST_LEN, buf))
+    {
+        return false;
+    }
+
+    // all big endian, temperature at 6..7
+    p_raw->temp = (int16_t)((buf[6] << 8) | buf[7]);
+    for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+    {
+        p_raw->accl[u8_k] = (int16_t)((buf[ 0 + 2*u8_k] << 8) | buf[ 1 + 2*u8_k]);
+        p_raw->gyro[u8_k] = (int16_t)((buf[ 8 + 2*u8_k] << 8) | buf[ 9 + 2*u8_k]);
+    }
+
+    // HMC5883 register order is X, Z, Y
+    p_raw->magn[0] = (int16_t)((buf[14] << 8) | buf[15]);
+    p_raw->magn[2] = (int16_t)((buf[16] << 8) | buf[17]);
+    p_raw->magn[1] = (int16_t)((buf[18] << 8) | buf[19]);
+    return true;
+}
+
+void MARGAux::toMARG(const sMARGRaw_t* p_raw, sMARG_t* p_marg)
+{
+    for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+    {
+        p_marg->accl.v[u8_k] = p_raw->accl[u8_k] * (SENSORS_GRAVITY_STANDARD / MPU_LSB_G);
+        p_marg->gyro.v[u8_k] = p_raw->gyro[u8_k] * (SENSORS_DPS_TO_RADS / MPU_LSB_DPS);
+    }
+    p_marg->magn.x = p_raw->magn[0] * (SENSORS_GAUSS_TO_MICROTESLA / HMC_LSB_GAUSS_XY);
+    p_marg->magn.y = p_raw->magn[1] * (SENSORS_GAUSS_TO_MICROTESLA / HMC_LSB_GAUSS_XY);
+    p_marg->magn.z = p_raw->magn[2] * (SENSORS_GAUSS_TO_MICROTESLA / HMC_LSB_GAUSS_Z);
+}
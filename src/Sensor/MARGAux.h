@@ -0,0 +1,47 @@
+#ifndef MARG_AUX_H_
+#define MARG_AUX_H_
+
+#include "SensorTypes.h"
+#include "Bus/I2CBus.h"
+#include "MPU6050Regs.h"
+
+// raw counts as read, accel 2G / gyro 250DPS / HMC5883 gain 1.3Ga
+typedef struct
+{
+    int16_t accl[3];
+    int16_t gyro[3];
+    int16_t magn[3];
+    int16_t temp;
+} sMARGRaw_t;
+
+// HMC5883 hung off the MPU6050 auxiliary bus: slave 0 of the MPU6050 I2C 
+// master mirrors the magnetometer into EXT_SENS_DATA, so a single burst 
+// from ACCEL_XOUT_H returns accel, temp, gyro and magn (20 bytes)
+class MARGAux {
+public:
+    MARGAux(I2CBus& bus);
+    ~MARGAux();
+
+    // MPU6050 must be awake, throws on a missing magnetometer or on any 
+    // register write that failed
+    void begin();
+
+    // one transaction for all nine axes
+    bool read(sMARGRaw_t* p_raw);
+
+    // Adafruit units: m/s^2, rad/s, uT
+    static void toMARG(const sMARGRaw_t* p_raw, sMARG_t* p_marg);
+
+    // die temperature [degC]
+    static float toTemp(const sMARGRaw_t* p_raw)
+    {
+        return p_raw->temp / MPU_LSB_DEGC + MPU_DEGC_OFFS;
+    }
+
+private:
+    I2CBus& mBus;
+
+    void setReg(uint8_t dev, uint8_t reg, uint8_t data);
+};
+
+#endif /* MARG_AUX_H_ */
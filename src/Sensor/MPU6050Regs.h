@@ -0,0 +1,30 @@
+#ifndef MPU6050_REGS_H_
+#define MPU6050_REGS_H_
+
+// MPU6050 registers and raw scales for the I2CBus based drivers, same 
+// addresses as MPU6050_RA_* in I2Cdevlib
+#define MPU_ADDR            0x68
+#define MPU_XA_OFFS_H       0x06
+#define MPU_XG_OFFS_USRH    0x13
+#define MPU_SMPLRT_DIV      0x19
+#define MPU_GYRO_CONFIG     0x1B
+#define MPU_ACCEL_CONFIG    0x1C
+#define MPU_FIFO_EN         0x23
+#define MPU_I2C_MST_CTRL    0x24
+#define MPU_I2C_SLV0_ADDR   0x25
+#define MPU_I2C_SLV0_REG    0x26
+#define MPU_I2C_SLV0_CTRL   0x27
+#define MPU_INT_PIN_CFG     0x37
+#define MPU_ACCEL_XOUT_H    0x3B
+#define MPU_TEMP_OUT_H      0x41
+#define MPU_USER_CTRL       0x6A
+#define MPU_FIFO_COUNTH     0x72
+#define MPU_FIFO_R_W        0x74
+
+// full scale 2G / 250DPS, set by the drivers
+#define MPU_LSB_G           16384.0
+#define MPU_LSB_DPS         131.0
+#define MPU_LSB_DEGC        340.0
+#define MPU_DEGC_OFFS       36.53
+
+#endif /* MPU6050_REGS_H_ */
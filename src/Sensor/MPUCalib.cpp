@@ -0,0 +1,176 @@
+#include "MPUCalib.h"
+#include "MPU6050Regs.h"
+#include <math.h>
+
+/* private macros ------------------------------------------------------------*/
+#define CALIB_AVG_MIN       8       // samples per batch while far off
+#define CALIB_AVG_MAX       32      // near the noise floor and to confirm
+#define CALIB_NEAR          4       // x tolerance that counts as near
+#define CALIB_ACCL_TOL      2.0     // [mg]
+#define CALIB_GYRO_TOL      0.1     // [dps]
+#define CALIB_SETTLE        2       // sample periods after an offset write
+
+#define FS_SEL(cfg)         (((cfg) >> 3) & 0x03)
+#define OFFS_MIN            -32768
+#define OFFS_MAX            32767
+
+MPUCalib::MPUCalib(I2CBus& bus, Clock& clock, uint32_t period_us)
+    : mBus{bus}
+    , mClock{clock}
+    , mPeriod_us{period_us}
+{
+}
+
+MPUCalib::~MPUCalib()
+{
+}
+
+bool MPUCalib::run(uint32_t maxSamples, sMPUCalib_t* p_result)
+{
+    uint8_t cfg[2];
+    float mean[6];
+    float lsbG;
+    float lsbDps;
+    float acclPerOffs;
+    float gyroPerOffs;
+    float err;
+    int32_t offs;
+    uint32_t count = CALIB_AVG_MIN;
+
+    // offset registers have fixed scales (16G / 1000DPS), readings follow FS
+    if (!mBus.read(MPU_ADDR, MPU_GYRO_CONFIG, 2, cfg) ||
+        !readOffsets(MPU_XA_OFFS_H, p_result->offsAccl) ||
+        !readOffsets(MPU_XG_OFFS_USRH, p_result->offsGyro))
+    {
+        return false;
+    }
+    lsbDps = MPU_LSB_DPS / (1 << FS_SEL(cfg[0]));
+    lsbG = MPU_LSB_G / (1 << FS_SEL(cfg[1]));
+    gyroPerOffs = 4.0 / (1 << FS_SEL(cfg[0]));
+    acclPerOffs = 8.0 / (1 << FS_SEL(cfg[1]));
+
+    p_result->iters = 0;
+    p_result->samples = 0;
+    p_result->converged = false;
+    while ((p_result->samples + count) <= maxSamples)
+    {
+        if (!average(count, mean))
+        {
+            return false;
+        }
+        p_result->samples += count;
+        p_result->iters++;
+
+        // gravity stays on z
+        mean[2] -= lsbG;
+        p_result->residAccl = 0;
+        p_result->residGyro = 0;
+        for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+        {
+            p_result->residAccl = fmaxf(p_result->residAccl, 
+                                        fabsf(mean[u8_k]) * 1000 / lsbG);
+            p_result->residGyro = fmaxf(p_result->residGyro, 
+                                        fabsf(mean[u8_k + 3]) / lsbDps);
+        }
+
+        if ((CALIB_ACCL_TOL > p_result->residAccl) && 
+            (CALIB_GYRO_TOL > p_result->residGyro))
+        {
+            // a small batch can be lucky, confirm on a full one
+            if (CALIB_AVG_MAX == count)
+            {
+                p_result->converged = true;
+                break;
+            }
+            count = CALIB_AVG_MAX;
+            continue;
+        }
+        if ((CALIB_NEAR * CALIB_ACCL_TOL > p_result->residAccl) && 
+            (CALIB_NEAR * CALIB_GYRO_TOL > p_result->residGyro))
+        {
+            count = CALIB_AVG_MAX;
+        }
+
+        for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+        {
+            // accel bit 0 is reserved, the offset moves in steps of two
+            err = mean[u8_k] / acclPerOffs;
+            offs = p_result->offsAccl[u8_k] - 2 * lroundf(err / 2);
+            offs = (offs & ~1) | (p_result->offsAccl[u8_k] & 1);
+            p_result->offsAccl[u8_k] = (offs < OFFS_MIN) ? OFFS_MIN : 
+                                       (offs > OFFS_MAX) ? OFFS_MAX : offs;
+
+            offs = p_result->offsGyro[u8_k] - 
+                   lroundf(mean[u8_k + 3] / gyroPerOffs);
+            p_result->offsGyro[u8_k] = (offs < OFFS_MIN) ? OFFS_MIN : 
+                                       (offs > OFFS_MAX) ? OFFS_MAX : offs;
+        }
+        if (!writeOffsets(MPU_XA_OFFS_H, p_result->offsAccl) ||
+            !writeOffsets(MPU_XG_OFFS_USRH, p_result->offsGyro))
+        {
+            return false;
+        }
+
+        // let the filtered outputs catch up with the new offsets
+        mClock.sleepUntil(mClock.now() + CALIB_SETTLE * mPeriod_us);
+    }
+
+    return true;
+}
+
+bool MPUCalib::average(uint32_t count, float* p_mean)
+{
+    uint8_t buf[14];
+    int32_t sum[6] = {0};
+    uint32_t next_us = mClock.now();
+
+    for (uint32_t u32_i = 0; u32_i < count; u32_i++)
+    {
+        // accel, temperature, gyro in one burst
+        mClock.sleepUntil(next_us);
+        next_us += mPeriod_us;
+        if (!mBus.read(MPU_ADDR, MPU_ACCEL_XOUT_H, sizeof(buf), buf))
+        {
+            return false;
+        }
+        for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+        {
+            sum[u8_k]     += (int16_t)((buf[2*u8_k] << 8) | buf[2*u8_k + 1]);
+            sum[u8_k + 3] += (int16_t)((buf[2*u8_k + 8] << 8) | 
+                                       buf[2*u8_k + 9]);
+        }
+    }
+
+    for (uint8_t u8_k = 0; u8_k < 6; u8_k++)
+    {
+        p_mean[u8_k] = (float)sum[u8_k] / count;
+    }
+    return true;
+}
+
+bool MPUCalib::readOffsets(uint8_t reg, int16_t* p_offs)
+{
+    uint8_t buf[6];
+
+    if (!mBus.read(MPU_ADDR, reg, sizeof(buf), buf))
+    {
+        return false;
+    }
+    for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+    {
+        p_offs[u8_k] = (int16_t)((buf[2*u8_k] << 8) | buf[2*u8_k + 1]);
+    }
+    return true;
+}
+
+bool MPUCalib::writeOffsets(uint8_t reg, const int16_t* p_offs)
+{
+    uint8_t buf[6];
+
+    for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+    {
+        buf[2*u8_k]     = (uint16_t)p_offs[u8_k] >> 8;
+        buf[2*u8_k + 1] = (uint16_t)p_offs[u8_k] & 0xFF;
+    }
+    return mBus.write(MPU_ADDR, reg, sizeof(buf), buf);
+}
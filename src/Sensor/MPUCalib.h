@@ -0,0 +1,40 @@
+#ifndef MPU_CALIB_H_
+#define MPU_CALIB_H_
+
+#include "Bus/I2CBus.h"
+#include "Sched/Clock.h"
+
+typedef struct
+{
+    int16_t offsAccl[3];    // chip offset registers as written
+    int16_t offsGyro[3];
+    float residAccl;        // worst axis of the last batch [mg]
+    float residGyro;        // [dps]
+    uint16_t iters;
+    uint32_t samples;
+    bool converged;
+} sMPUCalib_t;
+
+// MPU6050 offset register calibration, device flat and still with z up. 
+// Each iteration averages burst reads of all six axes and corrects the 
+// offsets by the known register scale, batches grow once the residual gets 
+// close to the noise floor. Stops as soon as a full batch is in tolerance.
+class MPUCalib {
+public:
+    MPUCalib(I2CBus& bus, Clock& clock, uint32_t period_us);
+    ~MPUCalib();
+
+    // at most maxSamples data reads, false on a bus error
+    bool run(uint32_t maxSamples, sMPUCalib_t* p_result);
+
+private:
+    I2CBus& mBus;
+    Clock& mClock;
+    uint32_t mPeriod_us;
+
+    bool average(uint32_t count, float* p_mean);
+    bool readOffsets(uint8_t reg, int16_t* p_offs);
+    bool writeOffsets(uint8_t reg, const int16_t* p_offs);
+};
+
+#endif /* MPU_CALIB_H_ */
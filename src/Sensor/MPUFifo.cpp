@@ -0,0 +1,122 @@
+#include "MPUFifo.h"
+#include "MPU6050Regs.h"
+
+/* private macros ------------------------------------------------------------*/
+#define FIFO_EN_ACCL_GYRO   0x78    // XG, YG, ZG, ACCEL
+#define USER_FIFO_EN        0x40
+#define USER_FIFO_RESET     0x04
+
+#define FIFO_SIZE           1024
+#define FIFO_SAMPLE_LEN     12
+#define FIFO_CHUNK          10      // samples per read, fits the Wire buffer
+
+MPUFifo::MPUFifo(I2CBus& bus)
+    : mBus{bus}
+    , mPeriod_us{0}
+    , mTime_us{0}
+    , mOverflows{0}
+{
+}
+
+MPUFifo::~MPUFifo()
+{
+}
+
+void MPUFifo::begin(uint8_t divisor, uint32_t period_us)
+{
+    mPeriod_us = period_us;
+
+    // full scale the raw counts are converted with
+    mBus.writeByte(MPU_ADDR, MPU_GYRO_CONFIG, 0x00);
+    mBus.writeByte(MPU_ADDR, MPU_ACCEL_CONFIG, 0x00);
+    mBus.writeByte(MPU_ADDR, MPU_SMPLRT_DIV, divisor);
+
+    mBus.writeByte(MPU_ADDR, MPU_FIFO_EN, FIFO_EN_ACCL_GYRO);
+    reset();
+
+    mTime_us = 0;
+    mOverflows = 0;
+}
+
+void MPUFifo::reset()
+{
+    // at least a full FIFO worth of samples got lost
+    mTime_us += (FIFO_SIZE / FIFO_SAMPLE_LEN) * mPeriod_us;
+
+    mBus.writeByte(MPU_ADDR, MPU_USER_CTRL, USER_FIFO_RESET);
+    mBus.writeByte(MPU_ADDR, MPU_USER_CTRL, USER_FIFO_EN);
+}
+
+uint32_t MPUFifo::drain(sMARGBatch_t* p_batch, uint32_t max)
+{
+    uint8_t buf[FIFO_CHUNK * FIFO_SAMPLE_LEN];
+    uint32_t count;
+    uint32_t chunk;
+    uint32_t idx;
+
+    if (!mBus.read(MPU_ADDR, MPU_FIFO_COUNTH, 2, buf))
+    {
+        return 0;
+    }
+    count = (buf[0] << 8) | buf[1];
+
+    // full FIFO drops data, partial sample means we lost alignment
+    if ((count >= FIFO_SIZE) || (0 != (count % FIFO_SAMPLE_LEN)))
+    {
+        mOverflows++;
+        reset();
+        return 0;
+    }
+
+    count /= FIFO_SAMPLE_LEN;
+    if (count > max)
+    {
+        count = max;
+    }
+
+    for (uint32_t u32_i = 0; u32_i < count; u32_i += chunk)
+    {
+        chunk = count - u32_i;
+        if (chunk > FIFO_CHUNK)
+        {
+            chunk = FIFO_CHUNK;
+        }
+        if (!mBus.read(MPU_ADDR, MPU_FIFO_R_W, chunk * FIFO_SAMPLE_LEN, buf))
+        {
+            // bytes may be gone, start over aligned
+            mOverflows++;
+            reset();
+            return u32_i;
+        }
+
+        // big endian accel x,y,z then gyro x,y,z
+        for (uint32_t u32_j = 0; u32_j < chunk; u32_j++)
+        {
+            idx = u32_i + u32_j;
+            for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+            {
+                int16_t accl = (buf[12*u32_j + 2*u8_k] << 8) | buf[12*u32_j + 2*u8_k + 1];
+                int16_t gyro = (buf[12*u32_j + 6 + 2*u8_k] << 8) | buf[12*u32_j + 7 + 2*u8_k];
+
+                p_batch->accl[u8_k][idx] = accl * (SENSORS_GRAVITY_STANDARD / MPU_LSB_G);
+                p_batch->gyro[u8_k][idx] = gyro * (SENSORS_DPS_TO_RADS / MPU_LSB_DPS);
+            }
+            mTime_us += mPeriod_us;
+            p_batch->t_us[idx] = mTime_us;
+        }
+    }
+
+    return count;
+}
+
+bool MPUFifo::readTemp(float* p_temp)
+{
+    uint8_t buf[2];
+
+    if (!mBus.read(MPU_ADDR, MPU_TEMP_OUT_H, sizeof(buf), buf))
+    {
+        return false;
+    }
+    *p_temp = (int16_t)((buf[0] << 8) | buf[1]) / MPU_LSB_DEGC + MPU_DEGC_OFFS;
+    return true;
+}
@@ -0,0 +1,41 @@
+#ifndef MPU_FIFO_H_
+#define MPU_FIFO_H_
+
+#include "Fusion/FusionTypes.h"
+#include "Bus/I2CBus.h"
+
+// MPU6050 hardware FIFO with accel + gyro (12 bytes per sample). The chip 
+// keeps sampling at its own rate, drain() reads the count once and bursts 
+// out everything pending, so a late loop no longer loses samples.
+class MPUFifo {
+public:
+    MPUFifo(I2CBus& bus);
+    ~MPUFifo();
+
+    // sample rate is gyro rate / (divisor + 1), period_us must match it
+    void begin(uint8_t divisor, uint32_t period_us);
+
+    // up to max samples into accl / gyro / t_us, Adafruit units, timestamps 
+    // count sample periods (chip clock). Returns the samples read.
+    uint32_t drain(sMARGBatch_t* p_batch, uint32_t max);
+
+    // die temperature [degC], not part of the FIFO samples
+    bool readTemp(float* p_temp);
+
+    // FIFO resets after an overflow or a torn sample
+    uint32_t getOverflows() const
+    {
+        return mOverflows;
+    }
+
+private:
+    I2CBus& mBus;
+
+    uint32_t mPeriod_us;
+    uint32_t mTime_us;
+    uint32_t mOverflows;
+
+    void reset();
+};
+
+#endif /* MPU_FIFO_H_ */
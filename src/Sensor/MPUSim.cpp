@@ -0,0 +1,88 @@
+#include "MPUSim.h"
+#include "MPU6050Regs.h"
+#include <math.h>
+
+/* private macros ------------------------------------------------------------*/
+#define SIM_DATA_LEN        14      // accel, temperature, gyro
+#define FS_SEL(cfg)         (((cfg) >> 3) & 0x03)
+
+MPUSim::MPUSim(uint32_t seed)
+    : mBiasAccl{0, 0, 0}
+    , mBiasGyro{0, 0, 0}
+    , mNoiseAccl{0}
+    , mNoiseGyro{0}
+    , mRng{seed}
+    , mNoise{0.0, 1.0}
+{
+    attach(MPU_ADDR);
+}
+
+MPUSim::~MPUSim()
+{
+}
+
+void MPUSim::setBias(const int16_t* p_accl, const int16_t* p_gyro)
+{
+    for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+    {
+        mBiasAccl[u8_k] = p_accl[u8_k];
+        mBiasGyro[u8_k] = p_gyro[u8_k];
+    }
+}
+
+void MPUSim::setNoise(float accl, float gyro)
+{
+    mNoiseAccl = accl;
+    mNoiseGyro = gyro;
+}
+
+bool MPUSim::read(uint8_t dev, uint8_t reg, uint8_t len, uint8_t* p_data)
+{
+    // fresh sample whenever a read touches the data registers
+    if ((MPU_ADDR == dev) && (reg < MPU_ACCEL_XOUT_H + SIM_DATA_LEN) && 
+        (reg + len > MPU_ACCEL_XOUT_H))
+    {
+        sample();
+    }
+
+    return I2CBusMock::read(dev, reg, len, p_data);
+}
+
+void MPUSim::sample()
+{
+    uint8_t afs = FS_SEL(getReg(MPU_ADDR, MPU_ACCEL_CONFIG));
+    uint8_t gfs = FS_SEL(getReg(MPU_ADDR, MPU_GYRO_CONFIG));
+    float value;
+
+    for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+    {
+        value  = (float)mBiasAccl[u8_k] / (1 << afs);
+        value += (float)(getReg16(MPU_XA_OFFS_H + 2*u8_k) & ~1) * 8 / (1 << afs);
+        value += mNoiseAccl * mNoise(mRng);
+        if (2 == u8_k)
+        {
+            value += MPU_LSB_G / (1 << afs);
+        }
+        setReg16(MPU_ACCEL_XOUT_H + 2*u8_k, value);
+
+        value  = (float)mBiasGyro[u8_k] / (1 << gfs);
+        value += (float)getReg16(MPU_XG_OFFS_USRH + 2*u8_k) * 4 / (1 << gfs);
+        value += mNoiseGyro * mNoise(mRng);
+        setReg16(MPU_ACCEL_XOUT_H + 8 + 2*u8_k, value);
+    }
+}
+
+int16_t MPUSim::getReg16(uint8_t reg)
+{
+    return (int16_t)((getReg(MPU_ADDR, reg) << 8) | getReg(MPU_ADDR, reg + 1));
+}
+
+void MPUSim::setReg16(uint8_t reg, float value)
+{
+    int32_t raw = lroundf(value);
+
+    // saturates like the ADC
+    raw = (raw < -32768) ? -32768 : (raw > 32767) ? 32767 : raw;
+    setReg(MPU_ADDR, reg, (uint16_t)raw >> 8);
+    setReg(MPU_ADDR, reg + 1, (uint16_t)raw & 0xFF);
+}
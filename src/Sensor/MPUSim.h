@@ -0,0 +1,36 @@
+#ifndef MPU_SIM_H_
+#define MPU_SIM_H_
+
+#include "Bus/I2CBusMock.h"
+#include <random>
+
+// Simulated MPU6050 at MPU_ADDR for host runs, on top of the mock register 
+// file. Each data read samples a device lying flat: 1G on z plus a sensor 
+// bias and gaussian noise, shifted by the offset registers at their real 
+// scales (accel 16G with bit 0 reserved, gyro 1000DPS).
+class MPUSim : public I2CBusMock {
+public:
+    MPUSim(uint32_t seed = 1);
+    ~MPUSim();
+
+    // raw counts at 2G / 250DPS
+    void setBias(const int16_t* p_accl, const int16_t* p_gyro);
+    // rms counts at the current full scale
+    void setNoise(float accl, float gyro);
+
+    bool read(uint8_t dev, uint8_t reg, uint8_t len, uint8_t* p_data) override;
+
+private:
+    int16_t mBiasAccl[3];
+    int16_t mBiasGyro[3];
+    float mNoiseAccl;
+    float mNoiseGyro;
+    std::mt19937 mRng;
+    std::normal_distribution<float> mNoise;
+
+    void sample();
+    int16_t getReg16(uint8_t reg);
+    void setReg16(uint8_t reg, float value);
+};
+
+#endif /* MPU_SIM_H_ */
@@ -1,25 +1,13 @@
 #ifndef SENSOR_BASE_H_
 #define SENSOR_BASE_H_
 
-#include <Adafruit_Sensor.h>
-#include <Arduino_JSON.h>
+#include "SensorTypes.h"
+#include "Fusion/FusionTypes.h"
+#include "Calib/CalibBlob.h"
 #include "Logger/SensorLogger.h"
+#include "Logger/JSONWriter.h"
 
-typedef struct 
-{
-    sensors_vec_t magn;
-    sensors_vec_t gyro;
-    sensors_vec_t accl;
-} sMARG_t;
-
-typedef struct 
-{
-    float w;
-    float x;
-    float y;
-    float z;
-} sQuaternion_t;
-
+#define REPORT_JSON_LEN 1024    // all 15 keys even with FLT_MAX values
 
 class SensorBase {
 public:
@@ -28,55 +16,108 @@ public:
 
     virtual void init(uint32_t count) = 0;
     virtual void wait() = 0;
-    virtual void getEvent(sMARG_t* p_marg) = 0;
+    // false when no new sample came in, p_marg then keeps the last one
+    virtual bool getEvent(sMARG_t* p_marg) = 0;
     virtual void update(const sMARG_t* p_marg) = 0;
 
+    // burst of samples, filters override it with a loop over the arrays
+    virtual void updateBatch(const sMARGBatch_t* p_batch, uint32_t count)
+    {
+        sMARG_t marg;
+
+        for (uint32_t u32_i = 0; u32_i < count; u32_i++)
+        {
+            for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+            {
+                marg.magn.v[u8_k] = p_batch->magn[u8_k][u32_i];
+                marg.gyro.v[u8_k] = p_batch->gyro[u8_k][u32_i];
+                marg.accl.v[u8_k] = p_batch->accl[u8_k][u32_i];
+            }
+            update(&marg);
+        }
+    }
+
+    // warm start from a stored calibration, call before init()
+    virtual bool setCalib(const sCalibBlob_t* p_calib)
+    {
+        (void)p_calib;
+        return false;
+    }
+
+    // copy the settled calibration out, false while still unknown
+    virtual bool getCalib(sCalibBlob_t* p_calib)
+    {
+        (void)p_calib;
+        return false;
+    }
+
+    // changes when getCalib() has something new worth storing again
+    virtual uint32_t getCalibRev()
+    {
+        return 0;
+    }
+
+    // filter state for the pipeline sink, no conversion beyond units
+    virtual void getAttitude(sAttitude_t* p_att)
+    {
+        syncTilt();
+        p_att->tilt.roll    = mTiltRads.roll * SENSORS_RADS_TO_DPS;
+        p_att->tilt.pitch   = mTiltRads.pitch * SENSORS_RADS_TO_DPS;
+        p_att->tilt.heading = mTiltRads.heading * SENSORS_RADS_TO_DPS;
+        p_att->valid = ATT_TILT | ATT_HEADING;
+    }
+
     float getRoll()
     {
+        syncTilt();
         return mTiltRads.roll * SENSORS_RADS_TO_DPS;
     }
 
     float getPitch()
     {
+        syncTilt();
         return mTiltRads.pitch * SENSORS_RADS_TO_DPS;
     }
 
     float getYaw()
     {
+        syncTilt();
         return mTiltRads.heading * SENSORS_RADS_TO_DPS;
     }
 
-    virtual String getReport(const sMARG_t* p_marg, 
-                             const sensors_vec_t* p_tilt = nullptr,
-                             const sQuaternion_t* p_quat = nullptr)
+    // JSON straight into p_buf, returns length or 0 if len was too short
+    virtual uint32_t getReport(char* p_buf, uint32_t len,
+                               const sMARG_t* p_marg, 
+                               const sensors_vec_t* p_tilt = nullptr,
+                               const sQuaternion_t* p_quat = nullptr)
     {
-        JSONVar mData;
-
-        mData["gyroX"] = String(p_marg->gyro.x);
-        mData["gyroY"] = String(p_marg->gyro.y);
-        mData["gyroZ"] = String(p_marg->gyro.z);
-        mData["acclX"] = String(p_marg->accl.x);
-        mData["acclY"] = String(p_marg->accl.y);
-        mData["acclZ"] = String(p_marg->accl.z);
-        mData["magnX"] = String(p_marg->magn.x);
-        mData["magnY"] = String(p_marg->magn.y);
-        mData["magnZ"] = String(p_marg->magn.z);
+        JSONWriter json(p_buf, len);
+
+        json.add("gyroX", p_marg->gyro.x);
+        json.add("gyroY", p_marg->gyro.y);
+        json.add("gyroZ", p_marg->gyro.z);
+        json.add("acclX", p_marg->accl.x);
+        json.add("acclY", p_marg->accl.y);
+        json.add("acclZ", p_marg->accl.z);
+        json.add("magnX", p_marg->magn.x);
+        json.add("magnY", p_marg->magn.y);
+        json.add("magnZ", p_marg->magn.z);
 
         if (nullptr != p_tilt)
         {
-            mData["tiltY"] = String(p_tilt->heading);
-            mData["tiltR"] = String(p_tilt->roll);
-            mData["tiltP"] = String(p_tilt->pitch);
+            json.add("tiltY", p_tilt->heading);
+            json.add("tiltR", p_tilt->roll);
+            json.add("tiltP", p_tilt->pitch);
         }
 
         if (nullptr != p_quat)
         {
-            mData["quatX"] = String(p_quat->x);
-            mData["quatY"] = String(p_quat->y);
-            mData["quatZ"] = String(p_quat->z);
+            json.add("quatX", p_quat->x);
+            json.add("quatY", p_quat->y);
+            json.add("quatZ", p_quat->z);
         }
 
-        return JSON.stringify(mData);
+        return json.finish();
     }
 
 protected:
@@ -85,6 +126,9 @@ protected:
     sensors_vec_t mTiltRads;
 
     virtual void calibrate(uint32_t count) = 0;
+
+    // let filters which keep other state convert into mTiltRads on demand
+    virtual void syncTilt() {};
     
 };
 
@@ -1,8 +1,17 @@
 #include "SensorDMP.h"
+#include "Fusion/FastMath.h"
 
-SensorDMP::SensorDMP(uint8_t pin, SensorLogger& logger)
+/* private macros ------------------------------------------------------------*/
+#define DMP_WAIT_MS     20
+#define DMP_MSG_LEN     48
+#define DMP_SAMPLE_US   5000    // dmpInitialize sets 200Hz
+
+SensorDMP::SensorDMP(SampleEvent* p_event, SensorLogger& logger)
     : SensorBase{logger}
-    , mPin{pin}
+    , mEvent{p_event}
+    , mCalib{mBus, mClock, DMP_SAMPLE_US}
+    , mPackets{0}
+    , mWarm{false}
 {
 }
 
@@ -12,70 +21,174 @@ SensorDMP::~SensorDMP()
 
 void SensorDMP::init(uint32_t count)
 {
+    char msg[DMP_MSG_LEN];
+
     if (!mpu.testConnection()) 
     {
         throw ("MPU6050 error\n");
     }
 
     mpu.initialize();
-    if (0 !=  mpu.dmpInitialize())
+    if ((0 !=  mpu.dmpInitialize()) || 
+        (DMP_PACKET_LEN != mpu.dmpGetFIFOPacketSize()))
     {
         throw ("DMP error\n");
     }
+    snprintf(msg, sizeof(msg), "DMP loaded in %lu ms\n", 
+             (unsigned long)(mpu.dmpGetLoadTime() / 1000));
+    mLogger.write(msg);
 
-    mLogger.write("Calibrating MPU...\n");
-    calibrate(count);
+    if (mWarm)
+    {
+        // stored offsets, skip the PID loops
+        mpu.setXAccelOffset(mOffsAccl[0]);
+        mpu.setYAccelOffset(mOffsAccl[1]);
+        mpu.setZAccelOffset(mOffsAccl[2]);
+        mpu.setXGyroOffset(mOffsGyro[0]);
+        mpu.setYGyroOffset(mOffsGyro[1]);
+        mpu.setZGyroOffset(mOffsGyro[2]);
+    }
+    else
+    {
+        mLogger.write("Calibrating MPU...\n");
+        calibrate(count);
+    }
 
     // turn on the DMP, now that it's ready
     mpu.setDMPEnabled(true);
 
-    // enable Arduino interrupt detection
-    // pinMode(mPin, INPUT);
-    // attachInterrupt(mPin, NULL, RISING);
+    // DMP raises the pin for every packet
+    if (nullptr != mEvent)
+    {
+        mEvent->begin();
+    }
 }
 
 void SensorDMP::wait()
 {
-    while(!mpu.dmpGetCurrentFIFOPacket(mFifoBuf))
+    // every whole packet queued, no FIFO reset on backlog
+    while(0 == (mPackets = mpu.dmpGetFIFOPackets(mFifoBuf, DMP_PACKETS)))
     {
-        // wait blocking
+        // sleep until next packet, or keep polling without interrupt
+        if (nullptr != mEvent)
+        {
+            mEvent->wait(DMP_WAIT_MS);
+        }
     }
 }
 
 void SensorDMP::calibrate(uint32_t count)
 {
-    count /= 100;
-    mpu.CalibrateAccel(count);
-    mpu.CalibrateGyro(count);
+    sMPUCalib_t result;
+    char msg[DMP_MSG_LEN];
+
+    // count is the sample budget, usually done well before it
+    if (!mCalib.run(count, &result))
+    {
+        throw ("MPU6050 error\n");
+    }
+    snprintf(msg, sizeof(msg), "MPU %s after %u iterations\n", 
+             result.converged ? "calibrated" : "not converged", result.iters);
+    mLogger.write(msg);
+
+    // offsets moved under the DMP
+    mpu.resetFIFO();
+    mpu.resetDMP();
+}
+
+bool SensorDMP::setCalib(const sCalibBlob_t* p_calib)
+{
+    if (!(CALIB_DMP & p_calib->flags))
+    {
+        return false;
+    }
+
+    memcpy(mOffsAccl, p_calib->offsAccl, sizeof(mOffsAccl));
+    memcpy(mOffsGyro, p_calib->offsGyro, sizeof(mOffsGyro));
+    mWarm = true;
+    return true;
+}
+
+bool SensorDMP::getCalib(sCalibBlob_t* p_calib)
+{
+    // offsets live in the chip, valid once init() has run
+    p_calib->offsAccl[0] = mpu.getXAccelOffset();
+    p_calib->offsAccl[1] = mpu.getYAccelOffset();
+    p_calib->offsAccl[2] = mpu.getZAccelOffset();
+    p_calib->offsGyro[0] = mpu.getXGyroOffset();
+    p_calib->offsGyro[1] = mpu.getYGyroOffset();
+    p_calib->offsGyro[2] = mpu.getZGyroOffset();
+    p_calib->flags |= CALIB_DMP;
+    return true;
 }
 
 void SensorDMP::update(const sMARG_t* p_marg) 
+{
+    // quaternion comes with the packet in getEvent(), nothing to fuse
+    (void)p_marg;
+}
+
+void SensorDMP::getAttitude(sAttitude_t* p_att)
+{
+    p_att->quat.w = mQuat.w;
+    p_att->quat.x = mQuat.x;
+    p_att->quat.y = mQuat.y;
+    p_att->quat.z = mQuat.z;
+    p_att->valid = ATT_QUAT;
+}
+
+void SensorDMP::syncTilt()
 {
     VectorFloat gravity;
     float ypr[3];
 
     mpu.dmpGetGravity(&gravity, &mQuat);
+#ifdef USE_FASTMATH
+    getYawPitchRoll(ypr, &mQuat, &gravity);
+#else
     mpu.dmpGetYawPitchRoll(ypr, &mQuat, &gravity);
+#endif
 
     mTiltRads.heading =  ypr[0];
     mTiltRads.pitch   = -ypr[1];
     mTiltRads.roll    =  ypr[2];
 }
 
-void SensorDMP::getEvent(sMARG_t* p_marg)
+bool SensorDMP::getEvent(sMARG_t* p_marg)
 {
     VectorInt16 v;
+    uint8_t* p_packet;
 
-    mpu.dmpGetQuaternion(&mQuat, mFifoBuf);
+    // DMP quaternion is absolute, newest packet holds the current attitude
+    p_packet = &mFifoBuf[(mPackets - 1) * DMP_PACKET_LEN];
+    mpu.dmpGetQuaternion(&mQuat, p_packet);
 
     // copy data
-    mpu.dmpGetAccel(&v, mFifoBuf);    // MPU6050_RANGE_2_G
+    mpu.dmpGetAccel(&v, p_packet);    // MPU6050_RANGE_2_G
     p_marg->accl.x = ((float) v.x / 16384.0) * SENSORS_GRAVITY_STANDARD;
     p_marg->accl.y = ((float) v.y / 16384.0) * SENSORS_GRAVITY_STANDARD;
     p_marg->accl.z = ((float) v.z / 16384.0) * SENSORS_GRAVITY_STANDARD;
-    mpu.dmpGetGyro(&v, mFifoBuf);     // MPU6050_RANGE_2000_DEG
+    mpu.dmpGetGyro(&v, p_packet);     // MPU6050_RANGE_2000_DEG
     p_marg->gyro.x = ((float) v.x / 16.4) * SENSORS_DPS_TO_RADS;
     p_marg->gyro.y = ((float) v.y / 16.4) * SENSORS_DPS_TO_RADS;
     p_marg->gyro.z = ((float) v.z / 16.4) * SENSORS_DPS_TO_RADS;
+    return true;
+}
 
-}
\ No newline at end of file
+#ifdef USE_FASTMATH
+void SensorDMP::getYawPitchRoll(float* ypr, const Quaternion* q, 
+                                const VectorFloat* gravity)
+{
+    const VectorFloat* g = gravity;
+
+    // same as dmpGetYawPitchRoll, on the approximated math
+    ypr[0] = fusion_atan2(2*q->x*q->y - 2*q->w*q->z, 
+                          2*q->w*q->w + 2*q->x*q->x - 1);
+    ypr[1] = fusion_atan2(g->x, fusion_sqrt(g->y*g->y + g->z*g->z));
+    ypr[2] = fusion_atan2(g->y, g->z);
+    if (0 > g->z)
+    {
+        ypr[1] = ((0 < ypr[1]) ? PI : -PI) - ypr[1];
+    }
+}
+#endif
@@ -2,25 +2,48 @@
 #define SENSOR_DMP_H_
 
 #include "SensorBase.h"
+#include "Sched/SampleEvent.h"
+#include "Sched/ClockArduino.h"
+#include "Bus/I2CBusWire.h"
+#include "MPUCalib.h"
 #include <MPU6050_6Axis_MotionApps612.h>
 
-class SensorDMP: public SensorBase {
+#define DMP_PACKET_LEN  28      // MotionApps612: quat, accel, gyro
+#define DMP_PACKETS     8
+
+class SensorDMP final : public SensorBase {
 public:
-    SensorDMP(uint8_t pin, SensorLogger& logger);
+    SensorDMP(SampleEvent* p_event, SensorLogger& logger);
     ~SensorDMP();
 
     void init(uint32_t count) override;
     void wait() override;
-    void getEvent(sMARG_t* p_marg) override;
+    bool getEvent(sMARG_t* p_marg) override;
     void update(const sMARG_t* p_marg) override;
+    bool setCalib(const sCalibBlob_t* p_calib) override;
+    bool getCalib(sCalibBlob_t* p_calib) override;
+    void getAttitude(sAttitude_t* p_att) override;
 
 private:
     MPU6050 mpu;
-    uint8_t mPin;
-    uint8_t mFifoBuf[64];
+    SampleEvent* mEvent;
+    I2CBusWire mBus;
+    ClockArduino mClock;
+    MPUCalib mCalib;
+    uint8_t mFifoBuf[DMP_PACKETS * DMP_PACKET_LEN];
+    uint16_t mPackets;
     Quaternion mQuat;
 
+    int16_t mOffsAccl[3];
+    int16_t mOffsGyro[3];
+    bool mWarm;
+
     void calibrate(uint32_t count) override;
+    void syncTilt() override;
+#ifdef USE_FASTMATH
+    void getYawPitchRoll(float* ypr, const Quaternion* q, 
+                         const VectorFloat* gravity);
+#endif
 
 };
 
@@ -1,10 +1,45 @@
 #include "SensorFUSE.h"
+#include <I2Cdev.h>
 
-SensorFUSE::SensorFUSE(uint32_t freq, float fltrTau, SensorLogger& logger)
+/* private macros ------------------------------------------------------------*/
+#define MPU_ADDR        0x68
+#define MPU_INT_ENABLE  0x38
+#define MPU_DATA_RDY    0x01
+#define MPU_GYRO_HZ     8000    // DLPF off, Adafruit default 260Hz band
+
+#ifdef USE_FIFO
+// loop runs once per FIFO_DRAIN samples, freq is the chip sample rate
+#define FIFO_DRAIN      16
+#else
+#define FIFO_DRAIN      1
+#endif
+
+SensorFUSE::SensorFUSE(uint32_t freq, float fltrTau, SampleEvent* p_event, 
+                       SensorLogger& logger)
     : SensorBase{logger}
+    , mEvent{p_event}
+#if defined(USE_AUXMAG)
+    , mAux{mBus}
+#elif defined(USE_FIFO)
+    , mFifo{mBus}
+    , mBatchCnt{0}
+#endif
+    , mTemp{0}
+    , mLutAccl{false}
+#if defined(USE_EKF)
+    , mFusion{}
+#elif defined(USE_QUAT)
+    // same time constant as the complementary filter
+    , mFusion{(1-fltrTau) * freq / fltrTau, 0.0}
+#else
+    , mFusion{fltrTau}
+#endif
     , mFreq{freq}
-    , mFltrTau{fltrTau}
+    , mSched{mClock, FIFO_DRAIN * 1000000 / freq}
 {
+    static_assert(FIFO_DRAIN <= MARG_BATCH_MAX / 2, "FIFO_DRAIN too large");
+    static_assert(CALIB_LUT_BINS == BIAS_LUT_BINS, "CALIB_LUT_BINS mismatch");
+
     memset(&mTiltRads, 0x0, sizeof(sensors_vec_t));
 }
 
@@ -19,97 +54,179 @@ void SensorFUSE::init(uint32_t count)
         throw ("MPU6050 error\n");
     }
 
+#ifdef USE_AUXMAG
+    // magnetometer moves behind the MPU6050 master
+    mAux.begin();
+#endif
+
     mLogger.write("Calibrating MPU...\n");
     calibrate(count);
 
-    mLastTime_ms = millis();
+#ifdef USE_FIFO
+    // chip buffers at full rate, data ready would wake us for each sample
+    mFifo.begin((MPU_GYRO_HZ / mFreq) - 1, 1000000 / mFreq);
+#else
+    if (nullptr != mEvent)
+    {
+        // data ready at sample rate, drives the interrupt pin
+        mpu.setSampleRateDivisor((MPU_GYRO_HZ / mFreq) - 1);
+        I2Cdev::writeByte(MPU_ADDR, MPU_INT_ENABLE, MPU_DATA_RDY);
+        mEvent->begin();
+    }
+#endif
+
+    mSched.begin();
 }
 
 void SensorFUSE::wait()
 {
-    uint32_t ms;
-
-    ms = 1000.0 / (float)mFreq;
-    while(ms >= (millis()-mLastTime_ms)) 
+#ifndef USE_FIFO
+    // chip paces the loop, a lost edge only delays the read
+    if (nullptr != mEvent)
     {
-        // wait blocking
-    } ;
-    mLastTime_ms = millis();
+        mEvent->wait(2 * (1000 / mFreq) + 1);
+        mSched.mark();
+        return;
+    }
+#endif
+
+    mSched.wait();
 }
 
 void SensorFUSE::calibrate(uint32_t count)
 {
-    sensors_event_t accl;
-    sensors_event_t gyro;
-    sensors_event_t temp;
-    double sumAccl[3];
-    double sumGyro[3];
-
-    // reset to zero
-    memset(sumAccl, 0x0, sizeof(sumAccl));
-    memset(sumGyro, 0x0, sizeof(sumGyro));
+    // biases are refined in background while the device stays still
+    mBias.begin(count);
+}
 
-    // get a lot of sample
-    for(uint32_t u32_i = 0; u32_i < count; u32_i++) 
+bool SensorFUSE::setCalib(const sCalibBlob_t* p_calib)
+{
+    if (!(CALIB_IMU & p_calib->flags))
     {
-        mpu.getEvent(&accl, &gyro, &temp);
+        return false;
+    }
 
-        sumGyro[0] += gyro.gyro.x;
-        sumGyro[1] += gyro.gyro.y;
-        sumGyro[2] += gyro.gyro.z;
-        sumAccl[0] += accl.acceleration.x;
-        sumAccl[1] += accl.acceleration.y;
-        sumAccl[2] += accl.acceleration.z;
+    mBias.seed(p_calib->biasGyro, p_calib->biasAccl);
+    if (CALIB_LUT & p_calib->flags)
+    {
+        mLut.setGyroTable(p_calib->lutGyro, p_calib->lutGyroMask);
+        mLut.setAcclTable(p_calib->lutAccl, p_calib->lutAcclMask);
+    }
+    return true;
+}
 
-        delay(1);
+bool SensorFUSE::getCalib(sCalibBlob_t* p_calib)
+{
+    if (!mBias.isValid())
+    {
+        return false;
     }
 
-    // calculcate baseline
-    mBiasGyro.x = sumGyro[0] / count;
-    mBiasGyro.y = sumGyro[1] / count;
-    mBiasGyro.z = sumGyro[2] / count;
-    mBiasAccl.x = sumAccl[0] / count;
-    mBiasAccl.y = sumAccl[1] / count;
-    mBiasAccl.z = sumAccl[2] / count;
+    for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+    {
+        p_calib->biasGyro[u8_k] = mBias.getGyro().v[u8_k];
+        p_calib->biasAccl[u8_k] = mBias.getAccl().v[u8_k];
+    }
+    p_calib->lutGyroMask = mLut.getGyroTable(p_calib->lutGyro);
+    p_calib->lutAcclMask = mLut.getAcclTable(p_calib->lutAccl);
+    p_calib->flags |= CALIB_IMU | CALIB_LUT;
+    return true;
+}
 
-    // assume z-axis is perpendicular to earth gravity
-    mBiasAccl.z -= SENSORS_GRAVITY_STANDARD;
+uint32_t SensorFUSE::getCalibRev()
+{
+    // new temperature bins, refinements of known ones ride along
+    return mLut.getRev();
 }
 
 void SensorFUSE::update(const sMARG_t* p_marg) 
 {
-    const sensors_vec_t* p_accl;
-    const sensors_vec_t* p_gyro;
-    sensors_vec_t tiltAccl;
-    sensors_vec_t tiltGyro;
-    float dt;
-
-    p_accl = &(p_marg->accl);
-    p_gyro = &(p_marg->gyro);
-
-    // get tilt from gyroscope
-    dt = 1.0 / (float)mFreq;
-    tiltGyro.roll    = mTiltRads.roll    + p_gyro->x * dt;
-    tiltGyro.pitch   = mTiltRads.pitch   + p_gyro->y * dt;
-
-    // get tilt from accelerometer
-    tiltAccl.roll    =  atan2(p_accl->y, 
-                              sqrt(p_accl->x*p_accl->x + p_accl->z*p_accl->z));
-    tiltAccl.pitch   = -atan2(p_accl->x, 
-                              sqrt(p_accl->y*p_accl->y + p_accl->z*p_accl->z));
-
-    // sensor fusion using complementary filter
-    mTiltRads.roll   = (mFltrTau)   * (tiltGyro.roll)  + 
-                       (1-mFltrTau) * (tiltAccl.roll);
-    mTiltRads.pitch  = (mFltrTau)   * (tiltGyro.pitch) + 
-                       (1-mFltrTau) * (tiltAccl.pitch);
-    
-    // undefined for yaw
-    mTiltRads.heading = 0;
+#ifdef USE_FIFO
+    // whole drained burst, dt from the chip sample clock
+    updateBatch(&mBatch, mBatchCnt);
+#else
+    mFusion.update(p_marg, mSched.getDt());
+#if !defined(USE_QUAT) && !defined(USE_EKF)
+    mTiltRads.roll    = mFusion.getTilt().roll;
+    mTiltRads.pitch   = mFusion.getTilt().pitch;
+    mTiltRads.heading = mFusion.getTilt().heading;
+#endif
+#endif
+}
+
+void SensorFUSE::updateBatch(const sMARGBatch_t* p_batch, uint32_t count) 
+{
+    mFusion.update(p_batch, count);
+#if !defined(USE_QUAT) && !defined(USE_EKF)
+    mTiltRads.roll    = mFusion.getTilt().roll;
+    mTiltRads.pitch   = mFusion.getTilt().pitch;
+    mTiltRads.heading = mFusion.getTilt().heading;
+#endif
+}
+
+#if defined(USE_QUAT) || defined(USE_EKF)
+void SensorFUSE::getAttitude(sAttitude_t* p_att)
+{
+    // filter state as is, euler angles are left to the readers
+    p_att->quat = mFusion.getQuat();
+    p_att->valid = ATT_QUAT;
+}
+
+void SensorFUSE::syncTilt()
+{
+    mTiltRads = mFusion.getTilt();
 }
+#endif
 
-void SensorFUSE::getEvent(sMARG_t* p_marg)
+bool SensorFUSE::getEvent(sMARG_t* p_marg)
 {
+#ifdef USE_AUXMAG
+    sMARGRaw_t raw;
+
+    // one burst for all nine axes, keep last sample on a bus error
+    if (!mAux.read(&raw))
+    {
+        return false;
+    }
+    MARGAux::toMARG(&raw, p_marg);
+    mTemp = MARGAux::toTemp(&raw);
+#elif defined(USE_FIFO)
+    sensors_vec_t gyro;
+    sensors_vec_t accl;
+
+    // everything sampled since last call, in few bursts, temperature 
+    // moves slowly enough for one read per burst
+    mFifo.readTemp(&mTemp);
+    mBatchCnt = mFifo.drain(&mBatch, MARG_BATCH_MAX);
+    for (uint32_t u32_i = 0; u32_i < mBatchCnt; u32_i++)
+    {
+        for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+        {
+            gyro.v[u8_k] = mBatch.gyro[u8_k][u32_i];
+            accl.v[u8_k] = mBatch.accl[u8_k][u32_i];
+        }
+        compensate(&gyro, &accl);
+
+        for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+        {
+            mBatch.gyro[u8_k][u32_i] = gyro.v[u8_k];
+            mBatch.accl[u8_k][u32_i] = accl.v[u8_k];
+            mBatch.magn[u8_k][u32_i] = p_marg->magn.v[u8_k];
+        }
+    }
+    if (0 == mBatchCnt)
+    {
+        return false;
+    }
+
+    // newest sample is the one reported
+    for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+    {
+        p_marg->gyro.v[u8_k] = mBatch.gyro[u8_k][mBatchCnt - 1];
+        p_marg->accl.v[u8_k] = mBatch.accl[u8_k][mBatchCnt - 1];
+    }
+    return true;
+#else
     sensors_event_t accl;
     sensors_event_t gyro;
     sensors_event_t temp;
@@ -117,15 +234,51 @@ void SensorFUSE::getEvent(sMARG_t* p_marg)
     // read sensor
     mpu.getEvent(&accl, &gyro, &temp);
 
-    // get heatmap
-    gyro.gyro.x         -= mBiasGyro.x;
-    gyro.gyro.y         -= mBiasGyro.y;
-    gyro.gyro.z         -= mBiasGyro.z;
-    accl.acceleration.x -= mBiasAccl.x;
-    accl.acceleration.y -= mBiasAccl.y;
-    accl.acceleration.z -= mBiasAccl.z;
-
     // copy data
     memcpy(&(p_marg->gyro), &(gyro.gyro), sizeof(sensors_vec_t));
     memcpy(&(p_marg->accl), &(accl.acceleration), sizeof(sensors_vec_t));
+    mTemp = temp.temperature;
+#endif
+
+    compensate(&(p_marg->gyro), &(p_marg->accl));
+    return true;
+}
+
+void SensorFUSE::compensate(sensors_vec_t* p_gyro, sensors_vec_t* p_accl)
+{
+    sensors_vec_t biasGyro;
+    sensors_vec_t biasAccl;
+
+    // look for still periods, learn them at the current temperature
+    if (mBias.update(p_gyro, p_accl))
+    {
+        mLut.learnGyro(mTemp, &mBias.getStillGyro());
+
+        // accel only from the first flat still block like the boot 
+        // calibration assumes, each boot adds its own temperature
+        if (!mLutAccl && mBias.isLevel())
+        {
+            biasAccl = mBias.getStillAccl();
+            biasAccl.z -= SENSORS_GRAVITY_STANDARD;
+            mLut.learnAccl(mTemp, &biasAccl);
+            mLutAccl = true;
+        }
+    }
+
+    // temperature model, running estimate until it has data
+    if (!mLut.getGyro(mTemp, &biasGyro))
+    {
+        biasGyro = mBias.getGyro();
+    }
+    if (!mLut.getAccl(mTemp, &biasAccl))
+    {
+        biasAccl = mBias.getAccl();
+    }
+
+    // get heatmap
+    for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+    {
+        p_gyro->v[u8_k] -= biasGyro.v[u8_k];
+        p_accl->v[u8_k] -= biasAccl.v[u8_k];
+    }
 }
\ No newline at end of file
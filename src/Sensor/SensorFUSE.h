@@ -2,30 +2,86 @@
 #define SENSOR_FUSE_H_
 
 #include "SensorBase.h"
+#include "Fusion/FusionBias.h"
+#include "Fusion/FusionBiasLUT.h"
+#include "Sched/SampleEvent.h"
+#include "Sched/ClockArduino.h"
+#include "Sched/RateScheduler.h"
+#if defined(USE_EKF)
+#include "Fusion/FusionEKF.h"
+#elif defined(USE_QUAT)
+#include "Fusion/FusionQuat.h"
+#else
+#include "Fusion/FusionTilt.h"
+#endif
+#if defined(USE_AUXMAG) && defined(USE_FIFO)
+#error "USE_AUXMAG and USE_FIFO are exclusive"
+#endif
+#if defined(USE_AUXMAG) || defined(USE_FIFO)
+#include "Bus/I2CBusWire.h"
+#endif
+#if defined(USE_AUXMAG)
+#include "MARGAux.h"
+#elif defined(USE_FIFO)
+#include "MPUFifo.h"
+#endif
 #include <Adafruit_MPU6050.h>
 
-class SensorFUSE: public SensorBase {
+class SensorFUSE final : public SensorBase {
 public:
-    SensorFUSE(uint32_t freq, float fltrTau, SensorLogger& logger);
+    SensorFUSE(uint32_t freq, float fltrTau, SampleEvent* p_event, 
+               SensorLogger& logger);
     ~SensorFUSE();
 
     void init(uint32_t count) override;
     void wait() override;
-    void getEvent(sMARG_t* p_marg) override;
+    bool getEvent(sMARG_t* p_marg) override;
     void update(const sMARG_t* p_marg) override;
+    void updateBatch(const sMARGBatch_t* p_batch, uint32_t count) override;
+    bool setCalib(const sCalibBlob_t* p_calib) override;
+    bool getCalib(sCalibBlob_t* p_calib) override;
+    uint32_t getCalibRev() override;
+#if defined(USE_QUAT) || defined(USE_EKF)
+    void getAttitude(sAttitude_t* p_att) override;
+#endif
 
 private:
     Adafruit_MPU6050 mpu;
+    SampleEvent* mEvent;
+#if defined(USE_AUXMAG)
+    I2CBusWire mBus;
+    MARGAux mAux;
+#elif defined(USE_FIFO)
+    I2CBusWire mBus;
+    MPUFifo mFifo;
 
-    sensors_vec_t mBiasAccl;
-    sensors_vec_t mBiasGyro;
+    // drained by getEvent, fused by update
+    sMARGBatch_t mBatch;
+    uint32_t mBatchCnt;
+#endif
 
-    uint32_t mFreq;
-    uint32_t mLastTime_ms;
+    FusionBias mBias;
+    FusionBiasLUT mLut;
+    float mTemp;            // die temperature of the current sample [degC]
+    bool mLutAccl;          // accel learned this boot
+
+#if defined(USE_EKF)
+    FusionEKF mFusion;
+#elif defined(USE_QUAT)
+    FusionQuat mFusion;
+#else
+    FusionTilt mFusion;
+#endif
 
-    float mFltrTau;
+    uint32_t mFreq;
+    ClockArduino mClock;
+    RateScheduler mSched;
 
     void calibrate(uint32_t count) override;
+    void compensate(sensors_vec_t* p_gyro, sensors_vec_t* p_accl);
+#if defined(USE_QUAT) || defined(USE_EKF)
+    void syncTilt() override;
+#endif
 };
 
 #endif /* SENSOR_FUSE_H_ */
\ No newline at end of file
@@ -1,11 +1,14 @@
 #include "SensorMagnet.h"
 
-SensorMagnet::SensorMagnet(float declDeg, float declMin, SensorLogger& logger)
+SensorMagnet::SensorMagnet(I2CQueue& queue, float declDeg, float declMin, 
+                           SensorLogger& logger)
     : SensorBase{logger}
+    , hmc{queue}
+    , mFusion{declDeg, declMin}
+    , mCount{0}
+    , mSamples{0}
+    , mWarm{false}
 {
-    // Set declination angle on your location and fix heading
-    // You can find your declination on: http://magnetic-declination.com/
-    mDeclAngle = (declDeg + (declMin / 60.0)) * SENSORS_DPS_TO_RADS;
 }
 
 SensorMagnet::~SensorMagnet()
@@ -14,10 +17,9 @@ SensorMagnet::~SensorMagnet()
 
 void SensorMagnet::init(uint32_t count)
 {
-    if (!hmc.begin()) 
-    {
-        throw ("HMC5883L error\n");
-    }
+#ifndef USE_AUXMAG
+    hmc.begin();
+#endif
 
     mLogger.write("Calibrating HMC...\n");
     calibrate(count);
@@ -25,68 +27,119 @@ void SensorMagnet::init(uint32_t count)
 
 void SensorMagnet::calibrate(uint32_t count)
 {
-    sensors_event_t magn;
-    float rngX[2];
-    float rngY[2];
-    float rngZ[2];
-
-    // reset to zero
-    memset(rngX, 0x0, sizeof(rngX));
-    memset(rngY, 0x0, sizeof(rngY));
-    memset(rngZ, 0x0, sizeof(rngZ));
-
-    // get a lot of sample
-    for(uint32_t u32_i = 0; u32_i < count; u32_i++) 
+    // stored range is kept and widened further
+    mCount = count;
+    if (mWarm)
+    {
+        return;
+    }
+
+    // hard iron offset follows the range seen by getEvent from now on
+    mSamples = 0;
+    memset(&mBias, 0x0, sizeof(sensors_vec_t));
+    for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
     {
-        hmc.getEvent(&magn);
+        mRng[u8_k][0] =  1e9;
+        mRng[u8_k][1] = -1e9;
+    }
+}
+
+bool SensorMagnet::setCalib(const sCalibBlob_t* p_calib)
+{
+    if (!(CALIB_MAGN & p_calib->flags))
+    {
+        return false;
+    }
 
-        // Determine Min / Max values
-        getRange(magn.magnetic.x, rngX);
-        getRange(magn.magnetic.y, rngY);
-        getRange(magn.magnetic.z, rngZ);
+    for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+    {
+        mRng[u8_k][0] = p_calib->rangeMagn[u8_k][0];
+        mRng[u8_k][1] = p_calib->rangeMagn[u8_k][1];
+        mBias.v[u8_k] = (mRng[u8_k][0] + mRng[u8_k][1]) / 2.0;
+    }
+    mWarm = true;
+    return true;
+}
 
-        delay(1);
+bool SensorMagnet::getCalib(sCalibBlob_t* p_calib)
+{
+    // as many samples as the old blocking calibration took
+    if (!mWarm && (mCount > mSamples))
+    {
+        return false;
     }
 
-    // calculcate offset
-    mBias.x = (rngX[0] + rngX[1]) / 2.0;
-    mBias.y = (rngY[0] + rngY[1]) / 2.0;
-    mBias.z = (rngZ[0] + rngZ[1]) / 2.0;
+    for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+    {
+        p_calib->rangeMagn[u8_k][0] = mRng[u8_k][0];
+        p_calib->rangeMagn[u8_k][1] = mRng[u8_k][1];
+    }
+    p_calib->flags |= CALIB_MAGN;
+    return true;
 }
 
 void SensorMagnet::update(const sMARG_t* p_marg) 
 {
-    const sensors_vec_t* p_mag;
-    float yaw;
-
-    p_mag = &(p_marg->magn);
-
-    yaw = atan2(p_mag->x, sqrt(p_mag->y*p_mag->y + p_mag->z*p_mag->z));
-    
-    // fix heading in current location
-    yaw += mDeclAngle;
-    
-    // correct angle
-    yaw = fixAngle(yaw);
-    
+    mFusion.update(p_marg);
+
     // Assing only yaw
-    mTiltRads.heading = yaw;
+    mTiltRads.heading = mFusion.getHeading();
 }
 
-void SensorMagnet::getEvent(sMARG_t* p_marg)
+void SensorMagnet::updateBatch(const sMARGBatch_t* p_batch, uint32_t count) 
 {
-    sensors_event_t magn;
+    mFusion.update(p_batch, count);
 
-    // read sensor
-    hmc.getEvent(&magn);
+    // Assing only yaw
+    mTiltRads.heading = mFusion.getHeading();
+}
 
-    // get heatmap
-    magn.magnetic.x -= mBias.x;
-    magn.magnetic.y -= mBias.y;
-    magn.magnetic.z -= mBias.z;
+bool SensorMagnet::getEvent(sMARG_t* p_marg)
+{
+    sensors_vec_t magn;
+
+#ifdef USE_AUXMAG
+    // raw field read along with the imu, SensorPair only gets here after 
+    // a good burst, otherwise the field is last step's corrected one
+    memcpy(&magn, &(p_marg->magn), sizeof(sensors_vec_t));
+#else
+    // newest sample the bus worker brought in, the next one is queued
+    if (!hmc.read(&magn))
+    {
+        return false;
+    }
+#endif
+
+    if (mCount > mSamples)
+    {
+        mSamples++;
+    }
+
+    // Determine Min / Max values, then calculcate offset
+    for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+    {
+        getRange(magn.v[u8_k], mRng[u8_k]);
+        mBias.v[u8_k] = (mRng[u8_k][0] + mRng[u8_k][1]) / 2.0;
+    }
+
+    // hard & soft iron fit keeps running in background
+    mFit.update(&magn);
+
+    // get heatmap, min/max offset until the fit converged
+    if (mFit.isValid())
+    {
+        mFit.correct(&magn);
+    }
+    else
+    {
+        magn.x -= mBias.x;
+        magn.y -= mBias.y;
+        magn.z -= mBias.z;
+    }
 
     // copy data
-    memcpy(&(p_marg->magn), &(magn.magnetic), sizeof(sensors_vec_t));
+    memcpy(&(p_marg->magn), &magn, sizeof(sensors_vec_t));
+    return true;
 }
 
 void SensorMagnet::getRange(float val, float rng[2])
@@ -103,20 +156,3 @@ void SensorMagnet::getRange(float val, float rng[2])
         rng[1] = val;
     }
 }
-
-float SensorMagnet::fixAngle(float heading)
-{
-    // Correct for when signs are reversed.
-    if (0 > heading)
-    {
-        heading += 2.0 * PI;
-    }
-        
-    // Check for wrap due to addition of declination.
-    else if ((2*PI) < heading)
-    {
-        heading -= 2.0 * PI;
-    }
-
-    return (heading);
-}
\ No newline at end of file
@@ -2,7 +2,9 @@
 #define SENSOR_MAGNET_H_
 
 #include "SensorBase.h"
-#include <Adafruit_HMC5883_U.h>
+#include "Fusion/FusionHeading.h"
+#include "Fusion/FusionMagFit.h"
+#include "HMCAsync.h"
 
 typedef struct
 {
@@ -10,27 +12,36 @@ typedef struct
     float max;
 } VectorRange_t;
 
-class SensorMagnet : public SensorBase {
+class SensorMagnet final : public SensorBase {
 public:
-    SensorMagnet(float declDeg, float declMin, SensorLogger& logger);
+    SensorMagnet(I2CQueue& queue, float declDeg, float declMin, 
+                 SensorLogger& logger);
     ~SensorMagnet();
 
     void init(uint32_t count) override;
     void wait() override {};
-    void getEvent(sMARG_t* p_marg) override;
+    bool getEvent(sMARG_t* p_marg) override;
     void update(const sMARG_t* p_marg) override;
+    void updateBatch(const sMARGBatch_t* p_batch, uint32_t count) override;
+    bool setCalib(const sCalibBlob_t* p_calib) override;
+    bool getCalib(sCalibBlob_t* p_calib) override;
 
 private:
-    Adafruit_HMC5883_Unified hmc;
+    HMCAsync hmc;
+
+    FusionHeading mFusion;
+    FusionMagFit mFit;
 
     sensors_vec_t mBias;
-    
-    float mDeclAngle;
+    float mRng[3][2];
+
+    uint32_t mCount;
+    uint32_t mSamples;
+    bool mWarm;
 
     void calibrate(uint32_t count);
 
     void getRange(float val, float rng[2]);
-    float fixAngle(float heading);
 
 };
 
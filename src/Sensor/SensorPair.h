@@ -0,0 +1,73 @@
+#ifndef SENSOR_PAIR_H_
+#define SENSOR_PAIR_H_
+
+#include "SensorTypes.h"
+#include "Profile/LoopProfiler.h"
+
+// Inertial sensor paired with a magnetometer, acts as both pipeline source 
+// and filter: roll & pitch come from the imu, heading from the magnetometer.
+template<typename Imu, typename Magn>
+class SensorPair {
+public:
+    SensorPair(Imu& imu, Magn& magn)
+        : mImu{imu}
+        , mMagn{magn}
+    {
+    }
+
+    void init(uint32_t count)
+    {
+        // initalize imu sensor
+        mImu.init(count);
+
+        // initalize magnetic sensor
+        mMagn.init(count);
+    }
+
+    void begin() 
+    {
+    }
+
+    void wait()
+    {
+        mImu.wait();
+    }
+
+    bool getEvent(sMARG_t* p_marg)
+    {
+        // imu first, it may bring the raw magnetometer along (USE_AUXMAG)
+        {
+            PROF_SCOPE(PROF_IMU);
+            if (!mImu.getEvent(p_marg))
+            {
+                // magn field is last step's corrected one, feeding it to 
+                // the range and fit again would apply the offset twice
+                return false;
+            }
+        }
+        {
+            PROF_SCOPE(PROF_MAGN);
+            mMagn.getEvent(p_marg);
+        }
+        return true;
+    }
+
+    void update(const sMARG_t* p_marg)
+    {
+        mMagn.update(p_marg);
+        mImu.update(p_marg);
+    }
+
+    void getAttitude(sAttitude_t* p_att)
+    {
+        mImu.getAttitude(p_att);
+        p_att->tilt.heading = mMagn.getYaw();
+        p_att->valid |= ATT_HEADING;
+    }
+
+private:
+    Imu& mImu;
+    Magn& mMagn;
+};
+
+#endif /* SENSOR_PAIR_H_ */
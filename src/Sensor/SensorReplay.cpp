@@ -0,0 +1,157 @@
+#include "SensorReplay.h"
+#include <cstdio>
+#include <cstring>
+
+SensorReplay::SensorReplay(const char* path, float fltrTau, 
+                           float declDeg, float declMin, SensorLogger& logger)
+    : SensorBase{logger}
+    , mPath{path}
+    , mIndex{0}
+    , mTilt{fltrTau}
+    , mHeading{declDeg, declMin}
+    , mDt{0}
+{
+    memset(&mTiltRads, 0x0, sizeof(sensors_vec_t));
+}
+
+SensorReplay::~SensorReplay()
+{
+}
+
+void SensorReplay::init(uint32_t count)
+{
+    FILE* file;
+    char line[160];
+    sReplaySample_t sample;
+
+    file = fopen(mPath, "r");
+    if (nullptr == file)
+    {
+        throw ("Replay error\n");
+    }
+
+    // load the whole trace, so replay is not paced by file access
+    mTrace.clear();
+    while (nullptr != fgets(line, sizeof(line), file))
+    {
+        if (parse(line, &sample))
+        {
+            mTrace.push_back(sample);
+        }
+    }
+    fclose(file);
+
+    if (mTrace.empty())
+    {
+        throw ("Replay empty\n");
+    }
+
+    mLogger.write("Calibrating Replay...\n");
+    calibrate(count);
+}
+
+void SensorReplay::calibrate(uint32_t count)
+{
+    // trace is recorded after bias compensation, nothing to estimate
+    (void)count;
+    rewind();
+}
+
+void SensorReplay::rewind()
+{
+    mIndex = 0;
+    mDt = 0;
+}
+
+bool SensorReplay::getEvent(sMARG_t* p_marg)
+{
+    const sReplaySample_t* p_sample;
+
+    if (eof())
+    {
+        throw ("Replay end\n");
+    }
+
+    p_sample = &mTrace[mIndex];
+
+    // take sampling period from the trace itself
+    if (0 < mIndex)
+    {
+        mDt = (p_sample->t_us - mTrace[mIndex-1].t_us) / 1000000.0;
+    }
+    mIndex++;
+
+    // copy data
+    memcpy(p_marg, &(p_sample->marg), sizeof(sMARG_t));
+    return true;
+}
+
+void SensorReplay::update(const sMARG_t* p_marg) 
+{
+    mTilt.update(p_marg, mDt);
+    mHeading.update(p_marg);
+
+    mTiltRads.roll    = mTilt.getTilt().roll;
+    mTiltRads.pitch   = mTilt.getTilt().pitch;
+    mTiltRads.heading = mHeading.getHeading();
+}
+
+void SensorReplay::updateBatch(const sMARGBatch_t* p_batch, uint32_t count) 
+{
+    mTilt.update(p_batch, count);
+    mHeading.update(p_batch, count);
+
+    mTiltRads.roll    = mTilt.getTilt().roll;
+    mTiltRads.pitch   = mTilt.getTilt().pitch;
+    mTiltRads.heading = mHeading.getHeading();
+}
+
+uint32_t SensorReplay::getEvents(sMARGBatch_t* p_batch, uint32_t max)
+{
+    const sMARG_t* p_marg;
+    uint32_t count;
+
+    if (MARG_BATCH_MAX < max)
+    {
+        max = MARG_BATCH_MAX;
+    }
+
+    // scatter trace samples into the arrays
+    for (count = 0; (count < max) && !eof(); count++, mIndex++)
+    {
+        p_marg = &(mTrace[mIndex].marg);
+        p_batch->t_us[count] = mTrace[mIndex].t_us;
+        for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+        {
+            p_batch->magn[u8_k][count] = p_marg->magn.v[u8_k];
+            p_batch->gyro[u8_k][count] = p_marg->gyro.v[u8_k];
+            p_batch->accl[u8_k][count] = p_marg->accl.v[u8_k];
+        }
+    }
+
+    return count;
+}
+
+bool SensorReplay::parse(const char* line, sReplaySample_t* p_sample)
+{
+    unsigned long t_us;
+    sMARG_t* p_marg;
+    int n;
+
+    p_marg = &(p_sample->marg);
+    memset(p_marg, 0x0, sizeof(sMARG_t));
+
+    n = sscanf(line, "%lu %f %f %f %f %f %f %f %f %f", &t_us,
+               &(p_marg->gyro.x), &(p_marg->gyro.y), &(p_marg->gyro.z),
+               &(p_marg->accl.x), &(p_marg->accl.y), &(p_marg->accl.z),
+               &(p_marg->magn.x), &(p_marg->magn.y), &(p_marg->magn.z));
+
+    // comment, blank or truncated line
+    if (10 != n)
+    {
+        return false;
+    }
+
+    p_sample->t_us = (uint32_t)t_us;
+    return true;
+}
@@ -0,0 +1,60 @@
+#ifndef SENSOR_REPLAY_H_
+#define SENSOR_REPLAY_H_
+
+#include "SensorBase.h"
+#include "Fusion/FusionTilt.h"
+#include "Fusion/FusionHeading.h"
+#include <vector>
+
+// Trace file is plain text, one sample per line, '#' starts a comment:
+//   t_us gx gy gz ax ay az mx my mz
+// with gyro in rad/s, accel in m/s^2 and magnetic in uT, already bias 
+// compensated (what SensorFUSE & SensorMagnet getEvent() hand out).
+typedef struct
+{
+    uint32_t t_us;
+    sMARG_t marg;
+} sReplaySample_t;
+
+class SensorReplay final : public SensorBase {
+public:
+    SensorReplay(const char* path, float fltrTau, 
+                 float declDeg, float declMin, SensorLogger& logger);
+    ~SensorReplay();
+
+    void init(uint32_t count) override;
+    void wait() override {};
+    bool getEvent(sMARG_t* p_marg) override;
+    void update(const sMARG_t* p_marg) override;
+    void updateBatch(const sMARGBatch_t* p_batch, uint32_t count) override;
+
+    bool eof() const
+    {
+        return mIndex >= mTrace.size();
+    }
+
+    void rewind();
+
+    uint32_t getEvents(sMARGBatch_t* p_batch, uint32_t max);
+
+    size_t size() const
+    {
+        return mTrace.size();
+    }
+
+private:
+    const char* mPath;
+    std::vector<sReplaySample_t> mTrace;
+    size_t mIndex;
+
+    FusionTilt mTilt;
+    FusionHeading mHeading;
+
+    float mDt;
+
+    void calibrate(uint32_t count) override;
+    bool parse(const char* line, sReplaySample_t* p_sample);
+
+};
+
+#endif /* SENSOR_REPLAY_H_ */
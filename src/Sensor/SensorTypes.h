@@ -0,0 +1,37 @@
+#ifndef SENSOR_TYPES_H_
+#define SENSOR_TYPES_H_
+
+#include <Adafruit_Sensor.h>
+
+typedef struct 
+{
+    sensors_vec_t magn;
+    sensors_vec_t gyro;
+    sensors_vec_t accl;
+} sMARG_t;
+
+typedef struct 
+{
+    float w;
+    float x;
+    float y;
+    float z;
+} sQuaternion_t;
+
+// sAttitude_t::valid, parts the filter filled in from its own state, 
+// readers derive the rest with completeAttitude()
+#define ATT_TILT        0x01    // tilt.roll, tilt.pitch
+#define ATT_HEADING     0x02    // tilt.heading
+#define ATT_QUAT        0x04    // quat
+
+// fused sample handed from the sensor task to the reporting side
+typedef struct 
+{
+    uint32_t t_us;
+    sMARG_t marg;
+    sensors_vec_t tilt;     // degrees
+    sQuaternion_t quat;
+    uint8_t valid;
+} sAttitude_t;
+
+#endif /* SENSOR_TYPES_H_ */
@@ -0,0 +1,47 @@
+#include "SensorReporter.h"
+
+SensorReporter::SensorReporter(uint32_t period_ms, uint16_t port, 
+                               SensorBase& sensor, SensorLogger& logger, 
+                               SensorServer& server)
+    : mSensor{sensor}
+    , mLogger{logger}
+    , mServer{server}
+    , mPeriod_ms{period_ms}
+    , mLastTime_ms{0}
+    , mPort{port}
+{
+}
+
+SensorReporter::~SensorReporter()
+{
+}
+
+bool SensorReporter::due()
+{
+    if (mPeriod_ms < (millis() - mLastTime_ms))
+    {
+        mLastTime_ms = millis();
+        return true;
+    }
+    return false;
+}
+
+void SensorReporter::report(const sMARG_t* p_marg, sensors_vec_t* p_tilt)
+{
+    char json[REPORT_JSON_LEN];
+    uint32_t len;
+
+    {
+        PROF_SCOPE(PROF_LOGGER);
+        mLogger.report(WiFi.localIP().toString(), mPort, p_tilt);
+    }
+    {
+        PROF_SCOPE(PROF_JSON);
+        len = mSensor.getReport(json, sizeof(json), p_marg, p_tilt);
+    }
+    if (0 < len)
+    {
+        PROF_SCOPE(PROF_SERVER);
+        mServer.report(json);
+    }
+}
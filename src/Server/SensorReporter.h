@@ -0,0 +1,28 @@
+#ifndef SENSOR_REPORTER_H_
+#define SENSOR_REPORTER_H_
+
+#include "Sensor/SensorBase.h"
+#include "Logger/SensorLogger.h"
+#include "SensorServer.h"
+#include "Profile/LoopProfiler.h"
+
+class SensorReporter {
+public:
+    SensorReporter(uint32_t period_ms, uint16_t port, SensorBase& sensor, 
+                   SensorLogger& logger, SensorServer& server);
+    ~SensorReporter();
+
+    bool due();
+    void report(const sMARG_t* p_marg, sensors_vec_t* p_tilt);
+
+private:
+    SensorBase& mSensor;
+    SensorLogger& mLogger;
+    SensorServer& mServer;
+
+    uint32_t mPeriod_ms;
+    uint32_t mLastTime_ms;
+    uint16_t mPort;
+};
+
+#endif /* SENSOR_REPORTER_H_ */
@@ -58,7 +58,14 @@ void SensorServer::start()
     mServer.begin();
 }
 
-void SensorServer::report(String&& json)
+void SensorServer::on(const char* uri, std::function<String()> json)
 {
-    mEvent.send(json.c_str(), "readings", millis());
+    mServer.on(uri, HTTP_GET, [json](AsyncWebServerRequest *request) {
+        request->send(200, "application/json", json());
+    });
+}
+
+void SensorServer::report(const char* json)
+{
+    mEvent.send(json, "readings", millis());
 }
\ No newline at end of file
@@ -15,7 +15,10 @@ public:
 
     void init(const char* ssid, const char *pass);
     void start();
-    void report(String&& json);
+    void report(const char* json);
+
+    // GET handler answering with json() built on the async_tcp task
+    void on(const char* uri, std::function<String()> json);
 
 private:
     AsyncWebServer mServer;
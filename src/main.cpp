@@ -11,9 +11,23 @@
 *********/
 #include "main.h"
 #include <Wire.h>
+#include <atomic>
 #include "Logger/SensorLogger.h"
 #include "Server/SensorServer.h"
+#include "Server/SensorReporter.h"
 #include "Sensor/SensorMagnet.h"
+#include "Sensor/SensorPair.h"
+#include "Fusion/FusionPipeline.h"
+#include "Calib/CalibStore.h"
+#include "Calib/CalibStorageNVS.h"
+#include "Sched/SampleEventISR.h"
+#include "Sched/ClockArduino.h"
+#include "Sched/RingSink.h"
+#include "Bus/I2CBusWire.h"
+#include "Bus/I2CQueue.h"
+#ifdef I2CDEV_TRACE
+#include <I2CdevTrace.h>
+#endif
 
 /* private macros ------------------------------------------------------------*/
 #define LED_PIN         2
@@ -22,6 +36,18 @@
 #define CALIB_CNT       200
 #define REPORT_MS       250
 #define SAMPLE_HZ       100
+#define SAMPLE_RING     32
+
+// sensor task owns core 1, reporting shares core 0 with wifi
+#define SENSOR_CORE     1
+#define SENSOR_PRIO     5
+#define REPORT_CORE     0
+#define REPORT_PRIO     1
+#define REPORT_POLL_MS  10
+#define TASK_STACK      8192
+#define PROF_DUMP_MS    5000
+#define PROF_JSON_LEN   640
+#define I2C_JSON_LEN    1280
 
 /* private variables ---------------------------------------------------------*/
 SensorLogger logger(Serial, Wire);
@@ -29,27 +55,177 @@ SensorServer server(SVR_PORT, SVR_EVT, logger);
 
 #ifndef USE_DMP
 #include "Sensor/SensorFUSE.h"
-SensorBase&& mpu = SensorFUSE(SAMPLE_HZ, 0.98, logger);
+typedef SensorFUSE SensorIMU;
+SampleEventISR mpuEvent(MPU_PIN, RISING);
+SensorIMU mpu(SAMPLE_HZ, 0.98, &mpuEvent, logger);
 #else
+#ifdef USE_AUXMAG
+#error "USE_AUXMAG needs the raw MPU6050 path (no USE_DMP)"
+#endif
 #include "Sensor/SensorDMP.h"
-SensorBase&& mpu = SensorDMP(MPU_PIN, logger);
+typedef SensorDMP SensorIMU;
+// DMP configures INT pin as active low
+SampleEventISR mpuEvent(MPU_PIN, FALLING);
+SensorIMU mpu(&mpuEvent, logger);
 #endif
 
+// magnetometer transfers run on the bus worker, the sensor task never 
+// waits on them
+I2CBusWire wireBus;
+I2CQueue i2cQueue(wireBus);
+
 // For Sukun Malang declination angle is +0'46E 
-SensorMagnet hmc(0.0, 46.0, logger);
+SensorMagnet hmc(i2cQueue, 0.0, 46.0, logger);
+
+typedef SensorPair<SensorIMU, SensorMagnet> SensorSource;
+SensorSource source(mpu, hmc);
 
-#ifdef USE_AHRS
+#ifndef USE_AHRS
+typedef SensorSource SensorFilter;
+SensorFilter& filter = source;
+#else
 #include <Adafruit_AHRS.h>
+#include "Fusion/FusionAHRS.h"
 // pick your filter! slower == better quality output
-// Adafruit_NXPSensorFusion filter; // slowest
-// Adafruit_Madgwick filter;  // faster than NXP
-Adafruit_Mahony filter;  // fastest/smallest
+// typedef FusionAHRS<Adafruit_NXPSensorFusion> SensorFilter; // slowest
+// typedef FusionAHRS<Adafruit_Madgwick> SensorFilter;  // faster than NXP
+typedef FusionAHRS<Adafruit_Mahony> SensorFilter;  // fastest/smallest
+SensorFilter filter(SAMPLE_HZ);
 #endif
 
-sMARG_t marg;
-sensors_vec_t tilt;
-sQuaternion_t quat;
-uint32_t lastReport;
+CalibStorageNVS calibStorage("marg");
+CalibStore calib(calibStorage);
+bool calibSaved;
+uint32_t calibRev;
+// filled by the sensor task, stored by the report task which owns the 
+// logger and can afford the NVS commit
+sCalibBlob_t calibStage;
+std::atomic<bool> calibPending(false);
+
+SensorReporter reporter(REPORT_MS, SVR_PORT, mpu, logger, server);
+
+ClockArduino sysClock;
+RingSink<SAMPLE_RING>::ring_t ring;
+AttitudeSnapshot snapshot;
+RingSink<SAMPLE_RING> sink(sysClock, ring, &snapshot);
+
+FusionPipeline<SensorSource, SensorFilter, RingSink<SAMPLE_RING>> 
+    pipeline(source, filter, sink);
+
+/* private functions ---------------------------------------------------------*/
+static void loadCalib()
+{
+    // warm start when the stored blob covers both sensors
+    calibSaved = calib.load();
+    if (calibSaved)
+    {
+        calibSaved  = mpu.setCalib(calib.getBlob());
+        calibSaved &= hmc.setCalib(calib.getBlob());
+    }
+    calibStage = *calib.getBlob();
+}
+
+// sensor task side, only copies the state out while the report task is idle
+static void stageCalib()
+{
+    if (calibPending.load(std::memory_order_acquire))
+    {
+        return;
+    }
+
+    // again when the imu learned something new, e.g. a temperature bin
+    if (calibSaved && (calibRev == mpu.getCalibRev()))
+    {
+        return;
+    }
+
+    // store once both sensors settled, a failed save waits for the next rev
+    if (mpu.getCalib(&calibStage) && hmc.getCalib(&calibStage))
+    {
+        calibRev = mpu.getCalibRev();
+        calibSaved = true;
+        calibPending.store(true, std::memory_order_release);
+    }
+}
+
+// report task side
+static void saveCalib()
+{
+    if (!calibPending.load(std::memory_order_acquire))
+    {
+        return;
+    }
+
+    *calib.getBlob() = calibStage;
+    logger.write(calib.save() ? "Calibration saved\n" : "Calibration error\n");
+    calibPending.store(false, std::memory_order_release);
+}
+
+static void sensorTask(void* arg)
+{
+    (void)arg;
+    while(1)
+    {
+        pipeline.step();
+
+        stageCalib();
+    }
+}
+
+#ifdef USE_PROFILE
+static String getProfile()
+{
+    char buf[PROF_JSON_LEN];
+
+    LoopProfiler::get().toJSON(buf, sizeof(buf));
+    return String(buf);
+}
+#endif
+
+#ifdef I2CDEV_TRACE
+static String getI2CStats()
+{
+    char buf[I2C_JSON_LEN];
+
+    I2CdevTrace::toJSON(buf, sizeof(buf));
+    return String(buf);
+}
+#endif
+
+static void reportTask(void* arg)
+{
+    (void)arg;
+    sAttitude_t sample;
+#if defined(USE_PROFILE) || defined(I2CDEV_TRACE)
+    uint32_t dumpTime_ms = millis();
+#endif
+
+    while(1)
+    {
+        // reports are throttled, only the newest sample matters
+        if (ring.popLatest(&sample) && reporter.due())
+        {
+            completeAttitude(&sample);
+            reporter.report(&sample.marg, &sample.tilt);
+        }
+
+        saveCalib();
+
+#if defined(USE_PROFILE) || defined(I2CDEV_TRACE)
+        if (PROF_DUMP_MS < (millis() - dumpTime_ms))
+        {
+            dumpTime_ms = millis();
+#ifdef USE_PROFILE
+            Serial.println(getProfile());
+#endif
+#ifdef I2CDEV_TRACE
+            Serial.println(getI2CStats());
+#endif
+        }
+#endif
+        vTaskDelay(pdMS_TO_TICKS(REPORT_POLL_MS));
+    }
+}
 
 /* public functions ----------------------------------------------------------*/
 void setup() 
@@ -59,21 +235,48 @@ void setup()
     // i2c periph init
     Wire.begin(); 
     Wire.setClock(400000);
+    i2cQueue.begin();
 
     // initalize logger
     logger.init(115200, "Viewtrix Technology\n");
 
     try
     {
-        // initalize imu sensor
-        mpu.init(CALIB_CNT);
-
-        /* initalize magnetic sensor */
-        hmc.init(CALIB_CNT);
+        // initalize sensors & filter
+        loadCalib();
+        pipeline.init(CALIB_CNT);
 
         // initialize server
         server.init(SSID_NAME, SSID_PASS);
+        server.on("/attitude", [] {
+            sAttitude_t sample;
+            char buf[REPORT_JSON_LEN];
+
+            if (!snapshot.read(&sample))
+            {
+                return String("{}");
+            }
+            completeAttitude(&sample);
+            if (0 == mpu.getReport(buf, sizeof(buf), &sample.marg, 
+                                   &sample.tilt, &sample.quat))
+            {
+                return String("{}");
+            }
+            return String(buf);
+        });
+#ifdef USE_PROFILE
+        server.on("/profile", getProfile);
+#endif
+#ifdef I2CDEV_TRACE
+        server.on("/i2c", getI2CStats);
+#endif
         server.start();
+
+        // split acquisition and reporting
+        xTaskCreatePinnedToCore(sensorTask, "sensor", TASK_STACK, NULL, 
+                                SENSOR_PRIO, NULL, SENSOR_CORE);
+        xTaskCreatePinnedToCore(reportTask, "report", TASK_STACK, NULL, 
+                                REPORT_PRIO, NULL, REPORT_CORE);
     }
     catch(char const *error)
     {
@@ -84,55 +287,10 @@ void setup()
             delay(100);
         };
     }
-
-#ifdef USE_AHRS
-    filter.begin(SAMPLE_HZ);
-#endif
 }
 
 void loop() 
 {
-    // wait until sample time
-    mpu.wait();
-
-    // get sensor events
-    hmc.getEvent(&marg);
-    mpu.getEvent(&marg);
-
-    // update current position
-#ifndef USE_AHRS
-    hmc.update(&marg);
-    mpu.update(&marg);
-#else
-    // filter want gyro in dps
-    marg.gyro.x *= SENSORS_RADS_TO_DPS;
-    marg.gyro.y *= SENSORS_RADS_TO_DPS;
-    marg.gyro.z *= SENSORS_RADS_TO_DPS;
-
-    // update filter
-    filter.update(marg.gyro.x, marg.gyro.y, marg.gyro.z, 
-                  marg.accl.x, marg.accl.y, marg.accl.z, 
-                  marg.magn.x, marg.magn.y, marg.magn.z);
-#endif
-
-    // reporting
-    if (REPORT_MS < (millis() - lastReport))
-    {
-        lastReport = millis();
-        
-        // get tilt information
-#ifndef USE_AHRS
-        tilt.roll    = mpu.getRoll();
-        tilt.pitch   = mpu.getPitch();
-        tilt.heading = hmc.getYaw();
-#else
-        tilt.roll    = filter.getRoll();
-        tilt.pitch   = filter.getPitch();
-        tilt.heading = filter.getYaw();
-#endif
-
-        // report 
-        logger.report(WiFi.localIP().toString(), SVR_PORT, &tilt);
-        server.report(mpu.getReport(&marg, &tilt));
-    }
+    // all work runs in the pinned tasks
+    vTaskDelete(NULL);
 }
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include <unity.h>
+#include <stdio.h>
+#include "Bench.h"
+#include "Fusion/FusionPipeline.h"
+
+/* private macros ------------------------------------------------------------*/
+#define SAMPLES         4096
+#define ITERS           100000
+#define REPORT_EVERY    10          // one report per REPORT_EVERY samples
+
+/* private typedef -----------------------------------------------------------*/
+// counts reports, stands in for RingSink without the publish cost
+class CountSink {
+public:
+    bool due()
+    {
+        return 0 == (++mTick % REPORT_EVERY);
+    }
+
+    void report(sAttitude_t* p_att)
+    {
+        mCount++;
+        benchKeep(*p_att);
+    }
+
+    uint32_t getCount() const
+    {
+        return mCount;
+    }
+
+private:
+    uint32_t mTick = 0;
+    uint32_t mCount = 0;
+};
+
+/* private variables ---------------------------------------------------------*/
+static SensorLogger logger(stdout);
+static SensorReplay replay(BENCH_TRACE, 0.98, 0.0, 0.0, logger);
+
+void setUp(void)
+{
+    replay.rewind();
+}
+
+void tearDown(void)
+{
+}
+
+void test_dispatch_cost(void)
+{
+    // opaque to the optimizer, calls stay virtual as in the old sensor task
+    SensorBase* volatile p_base = &replay;
+    CountSink virtSink;
+    CountSink pipeSink;
+    FusionPipeline<SensorReplay, SensorReplay, CountSink> 
+        pipeline(replay, replay, pipeSink);
+    float tVirt;
+    float tPipe;
+
+    tVirt = benchRun([&](uint32_t u32_i) {
+        SensorBase& base = *p_base;
+        sAttitude_t sample;
+        (void)u32_i;
+
+        if (replay.eof())
+        {
+            replay.rewind();
+        }
+        base.wait();
+        base.getEvent(&sample.marg);
+        base.update(&sample.marg);
+        if (virtSink.due())
+        {
+            base.getAttitude(&sample);
+            virtSink.report(&sample);
+        }
+    }, ITERS);
+
+    replay.rewind();
+    tPipe = benchRun([&](uint32_t u32_i) {
+        (void)u32_i;
+
+        if (replay.eof())
+        {
+            replay.rewind();
+        }
+        pipeline.step();
+    }, ITERS);
+
+    printf("FusionPipeline vs virtual SensorBase, per sample\n");
+    benchPrint("SensorBase& (virtual)", tVirt);
+    benchPrint("FusionPipeline", tPipe, tVirt);
+
+    // same work done on both paths
+    TEST_ASSERT_EQUAL_UINT32(BENCH_RUNS * ITERS / REPORT_EVERY, 
+                             virtSink.getCount());
+    TEST_ASSERT_EQUAL_UINT32(virtSink.getCount(), pipeSink.getCount());
+}
+
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    if (!writeTrace(BENCH_TRACE, SAMPLES, 10000))
+    {
+        return 1;
+    }
+    replay.init(0);
+    remove(BENCH_TRACE);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_dispatch_cost);
+    return UNITY_END();
+}
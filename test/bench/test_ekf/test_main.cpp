@@ -0,0 +1,125 @@
+#include <unity.h>
+#include <math.h>
+#include "Bench.h"
+#include "Fusion/FusionEKF.h"
+#include "Fusion/FusionQuat.h"
+
+/* private macros ------------------------------------------------------------*/
+#define SAMPLES         4096        // multiple of MARG_BATCH_MAX
+#define BATCHES         (SAMPLES / MARG_BATCH_MAX)
+#define ITERS           50000
+#define SAMPLE_HZ       100
+#define PERIOD_US       (1000000 / SAMPLE_HZ)
+#define FLTR_TAU        0.98
+#define DT              (1.0f / SAMPLE_HZ)
+
+#define EQ_TILT         0.1         // [rad] EKF vs complementary
+
+/* private variables ---------------------------------------------------------*/
+static std::vector<sMARG_t> samples;
+static std::vector<sMARGBatch_t> batches;
+
+// same samples as struct of arrays, timestamps continue across batches
+static void fillBatches(void)
+{
+    batches.resize(BATCHES);
+    for (uint32_t u32_i = 0; u32_i < SAMPLES; u32_i++)
+    {
+        sMARGBatch_t* p_batch = &batches[u32_i / MARG_BATCH_MAX];
+        uint32_t n = u32_i % MARG_BATCH_MAX;
+
+        p_batch->t_us[n] = u32_i * PERIOD_US;
+        for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+        {
+            p_batch->magn[u8_k][n] = samples[u32_i].magn.v[u8_k];
+            p_batch->gyro[u8_k][n] = samples[u32_i].gyro.v[u8_k];
+            p_batch->accl[u8_k][n] = samples[u32_i].accl.v[u8_k];
+        }
+    }
+}
+
+// next batch in replay order, restamped on wrap so time never goes back
+static const sMARGBatch_t* nextBatch(void)
+{
+    static uint32_t u32_next = 0;
+
+    if ((0 < u32_next) && (0 == (u32_next % BATCHES)))
+    {
+        for (uint32_t u32_i = 0; u32_i < BATCHES; u32_i++)
+        {
+            for (uint8_t u8_k = 0; u8_k < MARG_BATCH_MAX; u8_k++)
+            {
+                batches[u32_i].t_us[u8_k] += SAMPLES * PERIOD_US;
+            }
+        }
+    }
+    return &batches[u32_next++ % BATCHES];
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_update_cost(void)
+{
+    FusionQuat quat((1 - FLTR_TAU) * SAMPLE_HZ / FLTR_TAU, 0.0);
+    FusionEKF ekf;
+    float tQuat;
+    float tEkf;
+
+    tQuat = benchRun([&](uint32_t u32_i) {
+        quat.update(&samples[u32_i % SAMPLES], DT);
+        benchKeep(quat.getQuat());
+    }, ITERS);
+
+    tEkf = benchRun([&](uint32_t u32_i) {
+        ekf.update(&samples[u32_i % SAMPLES], DT);
+        benchKeep(ekf.getQuat());
+    }, ITERS);
+
+    printf("FusionEKF vs FusionQuat, per update\n");
+    benchPrint("FusionQuat", tQuat);
+    benchPrint("FusionEKF", tEkf, tQuat);
+
+    // the extra cost still buys the same attitude
+    TEST_ASSERT_FLOAT_WITHIN(EQ_TILT, quat.getTilt().roll, ekf.getTilt().roll);
+    TEST_ASSERT_FLOAT_WITHIN(EQ_TILT, quat.getTilt().pitch, ekf.getTilt().pitch);
+}
+
+void test_batch_cost(void)
+{
+    FusionEKF ekf;
+    float tBatch;
+
+    tBatch = benchRun([&](uint32_t u32_i) {
+        (void)u32_i;
+        ekf.update(nextBatch(), MARG_BATCH_MAX);
+        benchKeep(ekf.getQuat());
+    }, ITERS / MARG_BATCH_MAX);
+
+    printf("FusionEKF, per sample in %u sample batches\n", MARG_BATCH_MAX);
+    benchPrint("FusionEKF batch", tBatch / MARG_BATCH_MAX);
+
+    TEST_ASSERT_TRUE(std::isfinite(ekf.getQuat().w));
+}
+
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    if (!benchSamples(&samples, SAMPLES, PERIOD_US))
+    {
+        return 1;
+    }
+    fillBatches();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_update_cost);
+    RUN_TEST(test_batch_cost);
+    return UNITY_END();
+}
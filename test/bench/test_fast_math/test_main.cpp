@@ -0,0 +1,148 @@
+#include <unity.h>
+#include <math.h>
+#include <stdlib.h>
+#include "Bench.h"
+#include "Fusion/FastMath.h"
+
+/* private macros ------------------------------------------------------------*/
+#define INPUTS          1024        // power of two, index masked
+#define ITERS           200000
+#define SWEEP           100000      // points of the error sweep
+
+#define MAX_INVSQRT     5e-6        // relative, bounds from FastMath.h
+#define MAX_SQRT        5e-6        // relative
+#define MAX_ATAN2       1.2e-5      // [rad]
+#define MAX_ASIN        7.5e-5      // [rad]
+
+/* private variables ---------------------------------------------------------*/
+static float pos[INPUTS];           // (0, 100]
+static float sgn[INPUTS];           // [-1, 1]
+
+static float urand(float lo, float hi)
+{
+    return lo + (hi - lo) * ((float)rand() / (float)RAND_MAX);
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_invsqrt(void)
+{
+    float tLib, tFast, err = 0.0f;
+
+    tLib = benchRun([](uint32_t u32_i) {
+        benchKeep(1.0f / sqrtf(pos[u32_i & (INPUTS - 1)]));
+    }, ITERS);
+    tFast = benchRun([](uint32_t u32_i) {
+        benchKeep(fast_invsqrt(pos[u32_i & (INPUTS - 1)]));
+    }, ITERS);
+
+    for (uint32_t u32_i = 1; u32_i <= SWEEP; u32_i++)
+    {
+        float x = 1e-3f * (float)u32_i;
+        float ref = 1.0f / sqrtf(x);
+        err = fmaxf(err, fabsf(fast_invsqrt(x) - ref) / ref);
+    }
+
+    printf("invsqrt, max rel err %.2e\n", err);
+    benchPrint("1/sqrtf", tLib);
+    benchPrint("fast_invsqrt", tFast, tLib);
+    TEST_ASSERT_TRUE(MAX_INVSQRT > err);
+}
+
+void test_sqrt(void)
+{
+    float tLib, tFast, err = 0.0f;
+
+    tLib = benchRun([](uint32_t u32_i) {
+        benchKeep(sqrtf(pos[u32_i & (INPUTS - 1)]));
+    }, ITERS);
+    tFast = benchRun([](uint32_t u32_i) {
+        benchKeep(fast_sqrt(pos[u32_i & (INPUTS - 1)]));
+    }, ITERS);
+
+    for (uint32_t u32_i = 1; u32_i <= SWEEP; u32_i++)
+    {
+        float x = 1e-3f * (float)u32_i;
+        float ref = sqrtf(x);
+        err = fmaxf(err, fabsf(fast_sqrt(x) - ref) / ref);
+    }
+
+    printf("sqrt, max rel err %.2e\n", err);
+    benchPrint("sqrtf", tLib);
+    benchPrint("fast_sqrt", tFast, tLib);
+    TEST_ASSERT_TRUE(MAX_SQRT > err);
+}
+
+void test_atan2(void)
+{
+    float tLib, tFast, err = 0.0f;
+
+    tLib = benchRun([](uint32_t u32_i) {
+        benchKeep(atan2f(sgn[u32_i & (INPUTS - 1)], sgn[(u32_i + 1) & (INPUTS - 1)]));
+    }, ITERS);
+    tFast = benchRun([](uint32_t u32_i) {
+        benchKeep(fast_atan2(sgn[u32_i & (INPUTS - 1)], sgn[(u32_i + 1) & (INPUTS - 1)]));
+    }, ITERS);
+
+    // full circle
+    for (uint32_t u32_i = 0; u32_i < SWEEP; u32_i++)
+    {
+        float a = 2.0f * (float)M_PI * (float)u32_i / SWEEP - (float)M_PI;
+        float y = sinf(a), x = cosf(a);
+        err = fmaxf(err, fabsf(fast_atan2(y, x) - atan2f(y, x)));
+    }
+
+    printf("atan2, max abs err %.2e rad\n", err);
+    benchPrint("atan2f", tLib);
+    benchPrint("fast_atan2", tFast, tLib);
+    TEST_ASSERT_TRUE(MAX_ATAN2 > err);
+}
+
+void test_asin(void)
+{
+    float tLib, tFast, err = 0.0f;
+
+    tLib = benchRun([](uint32_t u32_i) {
+        benchKeep(asinf(sgn[u32_i & (INPUTS - 1)]));
+    }, ITERS);
+    tFast = benchRun([](uint32_t u32_i) {
+        benchKeep(fast_asin(sgn[u32_i & (INPUTS - 1)]));
+    }, ITERS);
+
+    for (uint32_t u32_i = 0; u32_i <= SWEEP; u32_i++)
+    {
+        float x = 2.0f * (float)u32_i / SWEEP - 1.0f;
+        err = fmaxf(err, fabsf(fast_asin(x) - asinf(x)));
+    }
+
+    printf("asin, max abs err %.2e rad\n", err);
+    benchPrint("asinf", tLib);
+    benchPrint("fast_asin", tFast, tLib);
+    TEST_ASSERT_TRUE(MAX_ASIN > err);
+}
+
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    srand(1);
+    for (uint32_t u32_i = 0; u32_i < INPUTS; u32_i++)
+    {
+        pos[u32_i] = urand(1e-3f, 100.0f);
+        sgn[u32_i] = urand(-1.0f, 1.0f);
+    }
+
+    UNITY_BEGIN();
+    RUN_TEST(test_invsqrt);
+    RUN_TEST(test_sqrt);
+    RUN_TEST(test_atan2);
+    RUN_TEST(test_asin);
+    return UNITY_END();
+}
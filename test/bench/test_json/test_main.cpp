@@ -0,0 +1,158 @@
+#include <unity.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "Bench.h"
+#include "Logger/JSONWriter.h"
+
+/* private macros ------------------------------------------------------------*/
+#define SAMPLES         1024
+#define ITERS           100000
+#define REPORT_LEN      512         // reportTask buffer
+
+/* private typedef -----------------------------------------------------------*/
+// host stand-in for the old JSONVar + String(float) report, every key and 
+// value is its own heap string and stringify() builds one more
+class HeapJSON {
+public:
+    void add(const char* key, float val)
+    {
+        char num[JSON_FIXED_LEN];
+
+        snprintf(num, sizeof(num), "%.2f", val);
+        mNodes.push_back(std::make_pair(std::string(key), std::string(num)));
+    }
+
+    std::string stringify() const
+    {
+        std::string out("{");
+
+        for (size_t u32_i = 0; u32_i < mNodes.size(); u32_i++)
+        {
+            out += (0 == u32_i) ? "\"" : ",\"";
+            out += mNodes[u32_i].first;
+            out += "\":\"";
+            out += mNodes[u32_i].second;
+            out += "\"";
+        }
+        return out + "}";
+    }
+
+private:
+    std::vector<std::pair<std::string, std::string>> mNodes;
+};
+
+/* private variables ---------------------------------------------------------*/
+static std::vector<sMARG_t> samples;
+static SensorLogger logger(stdout);
+static SensorReplay sensor(BENCH_TRACE, 0.98, 0.0, 0.0, logger);
+static sensors_vec_t tilt;
+static sQuaternion_t quat;
+
+/* private functions ---------------------------------------------------------*/
+static std::string heapReport(const sMARG_t* p_marg)
+{
+    HeapJSON data;
+
+    data.add("gyroX", p_marg->gyro.x);
+    data.add("gyroY", p_marg->gyro.y);
+    data.add("gyroZ", p_marg->gyro.z);
+    data.add("acclX", p_marg->accl.x);
+    data.add("acclY", p_marg->accl.y);
+    data.add("acclZ", p_marg->accl.z);
+    data.add("magnX", p_marg->magn.x);
+    data.add("magnY", p_marg->magn.y);
+    data.add("magnZ", p_marg->magn.z);
+    data.add("tiltY", tilt.heading);
+    data.add("tiltR", tilt.roll);
+    data.add("tiltP", tilt.pitch);
+    data.add("quatX", quat.x);
+    data.add("quatY", quat.y);
+    data.add("quatZ", quat.z);
+
+    return data.stringify();
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_report_cost(void)
+{
+    char buf[REPORT_LEN];
+    float tHeap;
+    float tWriter;
+
+    tHeap = benchRun([&](uint32_t u32_i) {
+        benchKeep(heapReport(&samples[u32_i % SAMPLES]));
+    }, ITERS);
+
+    tWriter = benchRun([&](uint32_t u32_i) {
+        benchKeep(sensor.getReport(buf, sizeof(buf), 
+                                   &samples[u32_i % SAMPLES], &tilt, &quat));
+    }, ITERS);
+
+    printf("full report, MARG + tilt + quat\n");
+    benchPrint("heap strings + snprintf", tHeap);
+    benchPrint("JSONWriter", tWriter, tHeap);
+}
+
+void test_fixed_cost(void)
+{
+    char num[JSON_FIXED_LEN];
+    float tPrintf;
+    float tFixed;
+
+    tPrintf = benchRun([&](uint32_t u32_i) {
+        snprintf(num, sizeof(num), "%.2f", samples[u32_i % SAMPLES].accl.x);
+        benchKeep(num);
+    }, ITERS);
+
+    tFixed = benchRun([&](uint32_t u32_i) {
+        JSONWriter::fmtFixed2(num, samples[u32_i % SAMPLES].accl.x);
+        benchKeep(num);
+    }, ITERS);
+
+    printf("one value, two decimals\n");
+    benchPrint("snprintf %.2f", tPrintf);
+    benchPrint("fmtFixed2", tFixed, tPrintf);
+}
+
+void test_same_text(void)
+{
+    char buf[REPORT_LEN];
+
+    for (uint32_t u32_i = 0; u32_i < SAMPLES; u32_i++)
+    {
+        sensor.getReport(buf, sizeof(buf), &samples[u32_i], &tilt, &quat);
+        TEST_ASSERT_TRUE(heapReport(&samples[u32_i]) == buf);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    if (!benchSamples(&samples, SAMPLES))
+    {
+        return 1;
+    }
+    tilt.roll = 12.345f;
+    tilt.pitch = -3.21f;
+    tilt.heading = 271.5f;
+    quat.w = 0.7071f;
+    quat.x = 0.0f;
+    quat.y = -0.7071f;
+    quat.z = 0.0012f;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_report_cost);
+    RUN_TEST(test_fixed_cost);
+    RUN_TEST(test_same_text);
+    return UNITY_END();
+}
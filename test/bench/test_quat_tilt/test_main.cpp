@@ -0,0 +1,76 @@
+#include <unity.h>
+#include <math.h>
+#include "Bench.h"
+#include "Fusion/FusionTilt.h"
+#include "Fusion/FusionQuat.h"
+
+/* private macros ------------------------------------------------------------*/
+#define SAMPLES         4096
+#define ITERS           100000
+#define SAMPLE_HZ       100
+#define FLTR_TAU        0.98
+#define DT              (1.0f / SAMPLE_HZ)
+
+#define EQ_TILT         0.1         // [rad] Euler vs quaternion propagation
+
+/* private variables ---------------------------------------------------------*/
+static std::vector<sMARG_t> samples;
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_update_cost(void)
+{
+    FusionTilt tilt(FLTR_TAU);
+    // same time constant as SensorFUSE gives the Mahony mode
+    FusionQuat quat((1 - FLTR_TAU) * SAMPLE_HZ / FLTR_TAU, 0.0);
+    float tTilt;
+    float tQuat;
+    float tRead;
+
+    tTilt = benchRun([&](uint32_t u32_i) {
+        tilt.update(&samples[u32_i % SAMPLES], DT);
+        benchKeep(tilt.getTilt());
+    }, ITERS);
+
+    // attitude stays a quaternion, no trig per sample
+    tQuat = benchRun([&](uint32_t u32_i) {
+        quat.update(&samples[u32_i % SAMPLES], DT);
+        benchKeep(quat.getQuat());
+    }, ITERS);
+
+    // worst case, Euler angles read after every sample
+    tRead = benchRun([&](uint32_t u32_i) {
+        quat.update(&samples[u32_i % SAMPLES], DT);
+        benchKeep(quat.getTilt());
+    }, ITERS);
+
+    printf("FusionQuat vs FusionTilt, per update\n");
+    benchPrint("FusionTilt", tTilt);
+    benchPrint("FusionQuat", tQuat, tTilt);
+    benchPrint("FusionQuat + getTilt", tRead, tTilt);
+
+    // both still track the same motion
+    TEST_ASSERT_FLOAT_WITHIN(EQ_TILT, tilt.getTilt().roll, quat.getTilt().roll);
+    TEST_ASSERT_FLOAT_WITHIN(EQ_TILT, tilt.getTilt().pitch, quat.getTilt().pitch);
+}
+
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    if (!benchSamples(&samples, SAMPLES))
+    {
+        return 1;
+    }
+
+    UNITY_BEGIN();
+    RUN_TEST(test_update_cost);
+    return UNITY_END();
+}
@@ -0,0 +1,152 @@
+#include <unity.h>
+#include <thread>
+#include <mutex>
+#include <deque>
+#include "Bench.h"
+#include "Sched/SpscRing.h"
+
+/* private macros ------------------------------------------------------------*/
+#define RING_LEN        32          // SAMPLE_RING
+#define ITERS           1000000
+#define ITEMS           1000000
+
+/* private typedef -----------------------------------------------------------*/
+typedef SpscRing<sAttitude_t, RING_LEN> ring_t;
+
+// what the ring replaces, a bounded queue behind a mutex
+class LockQueue {
+public:
+    bool push(const sAttitude_t& item)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        if (RING_LEN - 1 <= mQueue.size())
+        {
+            return false;
+        }
+        mQueue.push_back(item);
+        return true;
+    }
+
+    bool pop(sAttitude_t* p_item)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        if (mQueue.empty())
+        {
+            return false;
+        }
+        *p_item = mQueue.front();
+        mQueue.pop_front();
+        return true;
+    }
+
+private:
+    std::mutex mMutex;
+    std::deque<sAttitude_t> mQueue;
+};
+
+/* private variables ---------------------------------------------------------*/
+static ring_t ring;
+static LockQueue queue;
+
+/* private functions ---------------------------------------------------------*/
+// one producer thread, consumer on the caller, time per item, false when 
+// an item was lost or came out of order
+template<typename Q>
+static bool crossThread(Q& q, float* p_perItem)
+{
+    uint32_t start;
+    uint32_t expect = 0;
+    bool inOrder = true;
+    sAttitude_t item = {};
+
+    start = LoopProfiler::cycles();
+    std::thread producer([&q]() {
+        sAttitude_t out = {};
+
+        for (uint32_t u32_i = 0; u32_i < ITEMS; u32_i++)
+        {
+            out.t_us = u32_i;
+            while (!q.push(out))
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    while (expect < ITEMS)
+    {
+        if (!q.pop(&item))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        inOrder = inOrder && (expect == item.t_us);
+        expect++;
+    }
+    producer.join();
+
+    *p_perItem = (float)(uint32_t)(LoopProfiler::cycles() - start) / ITEMS;
+    return inOrder;
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_single_thread(void)
+{
+    sAttitude_t item = {};
+    float tRing;
+    float tLock;
+
+    tLock = benchRun([&](uint32_t u32_i) {
+        item.t_us = u32_i;
+        queue.push(item);
+        queue.pop(&item);
+        benchKeep(item);
+    }, ITERS);
+
+    tRing = benchRun([&](uint32_t u32_i) {
+        item.t_us = u32_i;
+        ring.push(item);
+        ring.pop(&item);
+        benchKeep(item);
+    }, ITERS);
+
+    printf("push + pop, one thread, %u byte items\n", (unsigned)sizeof(item));
+    benchPrint("mutex + deque", tLock);
+    benchPrint("SpscRing", tRing, tLock);
+
+    TEST_ASSERT_EQUAL_UINT32(ITERS - 1, item.t_us);
+    TEST_ASSERT_EQUAL_UINT32(0, ring.getDropped());
+}
+
+void test_cross_thread(void)
+{
+    float tRing;
+    float tLock;
+
+    TEST_ASSERT_TRUE(crossThread(queue, &tLock));
+    TEST_ASSERT_TRUE(crossThread(ring, &tRing));
+
+    printf("producer to consumer thread, %u items\n", ITEMS);
+    benchPrint("mutex + deque", tLock);
+    benchPrint("SpscRing", tRing, tLock);
+}
+
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_single_thread);
+    RUN_TEST(test_cross_thread);
+    return UNITY_END();
+}
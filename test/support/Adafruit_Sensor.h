@@ -0,0 +1,34 @@
+#ifndef _ADAFRUIT_SENSOR_H
+#define _ADAFRUIT_SENSOR_H
+
+#include <stdint.h>
+
+// Host stand-in for the Adafruit Unified Sensor header, only the types and
+// constants the host-safe sources use. The library itself does not build 
+// without Arduino (its .cpp prints through Serial), so env:native leaves it
+// out and finds this header instead.
+#define SENSORS_GRAVITY_EARTH       (9.80665F)
+#define SENSORS_GRAVITY_STANDARD    (SENSORS_GRAVITY_EARTH)
+#define SENSORS_DPS_TO_RADS         (0.017453293F)
+#define SENSORS_RADS_TO_DPS         (57.29577793F)
+#define SENSORS_GAUSS_TO_MICROTESLA (100)
+
+typedef struct {
+    union {
+        float v[3];
+        struct {
+            float x;
+            float y;
+            float z;
+        };
+        struct {
+            float roll;
+            float pitch;
+            float heading;
+        };
+    };
+    int8_t status;
+    uint8_t reserved[3];
+} sensors_vec_t;
+
+#endif /* _ADAFRUIT_SENSOR_H */
@@ -0,0 +1,99 @@
+#ifndef BENCH_H_
+#define BENCH_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+#include "Profile/LoopProfiler.h"
+#include "Sensor/SensorReplay.h"
+#include "TraceGen.h"
+
+#define BENCH_RUNS      7
+#define BENCH_TRACE     "bench_trace.txt"
+
+// LoopProfiler::cycles() counts CPU cycles on target, ns on host
+#ifdef ARDUINO
+#define BENCH_UNIT      "cycles"
+#else
+#define BENCH_UNIT      "ns"
+#endif
+
+// keeps the optimizer from dropping a result nobody reads
+template<typename T>
+inline void benchKeep(const T& val)
+{
+    asm volatile("" : : "r"(&val) : "memory");
+}
+
+// median over BENCH_RUNS of the time per call of fn(u32_i), i < iters
+template<typename F>
+inline float benchRun(F fn, uint32_t iters)
+{
+    float runs[BENCH_RUNS];
+    float tmp;
+    uint32_t start;
+
+    for (uint8_t u8_k = 0; u8_k < BENCH_RUNS; u8_k++)
+    {
+        start = LoopProfiler::cycles();
+        for (uint32_t u32_i = 0; u32_i < iters; u32_i++)
+        {
+            fn(u32_i);
+        }
+        runs[u8_k] = (float)(uint32_t)(LoopProfiler::cycles() - start) / iters;
+    }
+
+    // insertion sort, a handful of runs
+    for (uint8_t u8_k = 1; u8_k < BENCH_RUNS; u8_k++)
+    {
+        for (uint8_t u8_j = u8_k; (0 < u8_j) && (runs[u8_j] < runs[u8_j - 1]); 
+             u8_j--)
+        {
+            tmp = runs[u8_j];
+            runs[u8_j] = runs[u8_j - 1];
+            runs[u8_j - 1] = tmp;
+        }
+    }
+    return runs[BENCH_RUNS / 2];
+}
+
+// one result line, speed up against ref when given
+inline void benchPrint(const char* name, float perCall, float ref = 0)
+{
+    if (0 < ref)
+    {
+        printf("  %-28s %10.1f %s/call  x%.2f\n", name, perCall, BENCH_UNIT, 
+               ref / perCall);
+    }
+    else
+    {
+        printf("  %-28s %10.1f %s/call\n", name, perCall, BENCH_UNIT);
+    }
+}
+
+// synthetic motion samples (see TraceGen.h) through SensorReplay, false 
+// when the trace cannot be written
+inline bool benchSamples(std::vector<sMARG_t>* p_out, uint32_t count, 
+                         uint32_t period_us = 10000)
+{
+    SensorLogger logger(stdout);
+    SensorReplay replay(BENCH_TRACE, 0.98, 0.0, 0.0, logger);
+    sMARG_t marg;
+
+    if (!writeTrace(BENCH_TRACE, count, period_us))
+    {
+        return false;
+    }
+    replay.init(0);
+    remove(BENCH_TRACE);
+
+    p_out->clear();
+    while (!replay.eof())
+    {
+        replay.getEvent(&marg);
+        p_out->push_back(marg);
+    }
+    return true;
+}
+
+#endif /* BENCH_H_ */
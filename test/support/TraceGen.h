@@ -0,0 +1,65 @@
+#ifndef TRACE_GEN_H_
+#define TRACE_GEN_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <math.h>
+#include <random>
+#include <Adafruit_Sensor.h>
+
+// Synthetic SensorReplay trace: the device rocks about roll and pitch 
+// (up to 35 deg) while it turns slowly, gyro is the angle rate, accel the 
+// gravity direction and magn a 48 uT field with 60 deg inclination, all 
+// with gaussian noise. Returns false when the file cannot be written.
+inline bool writeTrace(const char* path, uint32_t count, uint32_t period_us, 
+                       uint32_t seed = 1)
+{
+    const float g = SENSORS_GRAVITY_STANDARD;
+    const float fieldH = 24.0f;
+    const float fieldV = 41.6f;
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> noise(0.0f, 1.0f);
+    FILE* file;
+    float t, roll, pitch, yaw, dRoll, dPitch, dYaw;
+    float mx, my;
+
+    file = fopen(path, "w");
+    if (nullptr == file)
+    {
+        return false;
+    }
+
+    fprintf(file, "# t_us gx gy gz ax ay az mx my mz\n");
+    for (uint32_t u32_i = 0; u32_i < count; u32_i++)
+    {
+        t = u32_i * period_us * 1e-6f;
+        roll   = 0.6f * sinf(2.0f * (float)M_PI * 0.11f * t);
+        pitch  = 0.4f * sinf(2.0f * (float)M_PI * 0.07f * t + 1.0f);
+        yaw    = 0.3f * t;
+        dRoll  = 0.6f * 2.0f * (float)M_PI * 0.11f * 
+                 cosf(2.0f * (float)M_PI * 0.11f * t);
+        dPitch = 0.4f * 2.0f * (float)M_PI * 0.07f * 
+                 cosf(2.0f * (float)M_PI * 0.07f * t + 1.0f);
+        dYaw   = 0.3f;
+
+        // horizontal field turns with yaw, tilt ignored like FusionHeading
+        mx = fieldH * cosf(yaw);
+        my = fieldH * sinf(yaw);
+
+        fprintf(file, "%u %.6f %.6f %.6f %.5f %.5f %.5f %.3f %.3f %.3f\n",
+                (unsigned)(u32_i * period_us),
+                dRoll  + 0.002f * noise(rng),
+                dPitch + 0.002f * noise(rng),
+                dYaw   + 0.002f * noise(rng),
+                -g * sinf(pitch) + 0.02f * noise(rng),
+                 g * cosf(pitch) * sinf(roll) + 0.02f * noise(rng),
+                 g * cosf(pitch) * cosf(roll) + 0.02f * noise(rng),
+                mx + 0.2f * noise(rng), my + 0.2f * noise(rng), 
+                fieldV + 0.2f * noise(rng));
+    }
+
+    fclose(file);
+    return true;
+}
+
+#endif /* TRACE_GEN_H_ */
@@ -0,0 +1,159 @@
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
+#include "Calib/CalibStore.h"
+#include "Calib/CalibStorageFile.h"
+
+/* private macros ------------------------------------------------------------*/
+#define CALIB_PATH      "calib_test.bin"
+
+/* private variables ---------------------------------------------------------*/
+static CalibStorageFile storage(CALIB_PATH);
+
+/* private functions ---------------------------------------------------------*/
+// reference CRC-32 (IEEE), restamps a blob edited behind the store
+static uint32_t crc32(const void* p_data, size_t size)
+{
+    const uint8_t* p_byte = (const uint8_t*)p_data;
+    uint32_t crc = 0xFFFFFFFF;
+
+    for (size_t i = 0; i < size; i++)
+    {
+        crc ^= p_byte[i];
+        for (uint8_t u8_b = 0; u8_b < 8; u8_b++)
+        {
+            crc = (crc & 1) ? ((crc >> 1) ^ 0xEDB88320) : (crc >> 1);
+        }
+    }
+    return ~crc;
+}
+
+static void fillBlob(sCalibBlob_t* p_blob)
+{
+    p_blob->flags = CALIB_IMU | CALIB_MAGN | CALIB_LUT;
+    for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+    {
+        p_blob->biasGyro[u8_k] = 0.01 * (u8_k + 1);
+        p_blob->biasAccl[u8_k] = -0.2 * (u8_k + 1);
+        p_blob->rangeMagn[u8_k][0] = -40.0 - u8_k;
+        p_blob->rangeMagn[u8_k][1] =  45.0 + u8_k;
+        p_blob->lutGyro[5][u8_k] = 0.003 * u8_k;
+    }
+    p_blob->lutGyroMask = 1 << 5;
+}
+
+// blob as it sits in the file
+static bool readRaw(sCalibBlob_t* p_blob)
+{
+    return storage.read(p_blob, sizeof(sCalibBlob_t));
+}
+
+static bool writeRaw(const void* p_data, size_t size)
+{
+    return storage.write(p_data, size);
+}
+
+// saved blob, then edited and rewritten, load must fail and keep the old
+static void expectReject(sCalibBlob_t* p_blob)
+{
+    CalibStore store(storage);
+
+    TEST_ASSERT_TRUE(writeRaw(p_blob, sizeof(sCalibBlob_t)));
+    store.getBlob()->flags = CALIB_DMP;
+    TEST_ASSERT_FALSE(store.load());
+    TEST_ASSERT_EQUAL_UINT16(CALIB_DMP, store.getBlob()->flags);
+}
+
+void setUp(void)
+{
+    CalibStore store(storage);
+
+    fillBlob(store.getBlob());
+    TEST_ASSERT_TRUE(store.save());
+}
+
+void tearDown(void)
+{
+    remove(CALIB_PATH);
+}
+
+void test_round_trip(void)
+{
+    CalibStore store(storage);
+    sCalibBlob_t blob;
+
+    memset(&blob, 0x0, sizeof(sCalibBlob_t));
+    fillBlob(&blob);
+
+    TEST_ASSERT_TRUE(store.load());
+    TEST_ASSERT_EQUAL_HEX32(CALIB_MAGIC, store.getBlob()->magic);
+    TEST_ASSERT_EQUAL_UINT16(CALIB_VERSION, store.getBlob()->version);
+    TEST_ASSERT_EQUAL_MEMORY(&blob.flags, &(store.getBlob()->flags), 
+                             offsetof(sCalibBlob_t, crc) - 
+                             offsetof(sCalibBlob_t, flags));
+}
+
+void test_flipped_byte(void)
+{
+    sCalibBlob_t blob;
+
+    TEST_ASSERT_TRUE(readRaw(&blob));
+    ((uint8_t*)&blob.rangeMagn)[3] ^= 0x10;
+    expectReject(&blob);
+}
+
+void test_wrong_magic(void)
+{
+    sCalibBlob_t blob;
+
+    // crc restamped, only the header check can catch it
+    TEST_ASSERT_TRUE(readRaw(&blob));
+    blob.magic = ~CALIB_MAGIC;
+    blob.crc = crc32(&blob, offsetof(sCalibBlob_t, crc));
+    expectReject(&blob);
+}
+
+void test_wrong_version(void)
+{
+    sCalibBlob_t blob;
+
+    TEST_ASSERT_TRUE(readRaw(&blob));
+    blob.version = CALIB_VERSION - 1;
+    blob.crc = crc32(&blob, offsetof(sCalibBlob_t, crc));
+    expectReject(&blob);
+}
+
+void test_short_file(void)
+{
+    CalibStore store(storage);
+    sCalibBlob_t blob;
+
+    // torn write, the header is still good
+    TEST_ASSERT_TRUE(readRaw(&blob));
+    TEST_ASSERT_TRUE(writeRaw(&blob, sizeof(sCalibBlob_t) / 2));
+    TEST_ASSERT_FALSE(store.load());
+}
+
+void test_missing_file(void)
+{
+    CalibStore store(storage);
+
+    remove(CALIB_PATH);
+    TEST_ASSERT_FALSE(store.load());
+}
+
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_round_trip);
+    RUN_TEST(test_flipped_byte);
+    RUN_TEST(test_wrong_magic);
+    RUN_TEST(test_wrong_version);
+    RUN_TEST(test_short_file);
+    RUN_TEST(test_missing_file);
+    return UNITY_END();
+}
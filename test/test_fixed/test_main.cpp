@@ -0,0 +1,240 @@
+#include <unity.h>
+#include <stdio.h>
+#include <math.h>
+#include "Fusion/FusionTilt.h"
+#include "Fusion/FusionHeading.h"
+#include "Sensor/SensorReplay.h"
+#include "TraceGen.h"
+
+/* private macros ------------------------------------------------------------*/
+#define TRACE_PATH      "test_fixed_trace.txt"
+#define TRACE_LEN       6000        // 60 s at 100 Hz
+#define TRACE_US        10000
+#define FLTR_TAU        0.98
+
+#define EQ_TILT         0.01        // [rad] atan2 polynomial bound and dt
+#define EQ_HEADING      0.01        // [rad] rounding, both well below noise
+
+/* private variables ---------------------------------------------------------*/
+static SensorLogger logger(stdout);
+
+/* private functions ---------------------------------------------------------*/
+static int16_t toRaw(float val, float lsb)
+{
+    float raw = roundf(val * lsb);
+
+    return (int16_t)((32767 < raw) ? 32767 : ((-32768 > raw) ? -32768 : raw));
+}
+
+// quantize like the registers do, both paths then see the very same data
+static void quantize(const sMARG_t* p_in, sMARG_t* p_out, sMARGQ_t* p_outQ)
+{
+    const float lsbAccl = 16384.0f / SENSORS_GRAVITY_STANDARD;
+    const float lsbGyro = 131.0f * SENSORS_RADS_TO_DPS;
+    const float lsbMagn = 1100.0f / SENSORS_GAUSS_TO_MICROTESLA;
+    int16_t accl[3];
+    int16_t gyro[3];
+    int16_t magn[3];
+
+    for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+    {
+        accl[u8_k] = toRaw(p_in->accl.v[u8_k], lsbAccl);
+        gyro[u8_k] = toRaw(p_in->gyro.v[u8_k], lsbGyro);
+        magn[u8_k] = toRaw(p_in->magn.v[u8_k], lsbMagn);
+        p_out->accl.v[u8_k] = accl[u8_k] / lsbAccl;
+        p_out->gyro.v[u8_k] = gyro[u8_k] / lsbGyro;
+        p_out->magn.v[u8_k] = magn[u8_k] / lsbMagn;
+    }
+    toMARGQ(accl, gyro, magn, p_outQ);
+}
+
+static float angleDiff(float a, float b)
+{
+    float d = fmodf(fabsf(a - b), 2.0f * (float)M_PI);
+
+    return (d > (float)M_PI) ? (2.0f * (float)M_PI - d) : d;
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/* tests ---------------------------------------------------------------------*/
+static void test_saturate(void)
+{
+    const Q16_t big(30000.0f);
+    const Q16_t tiny(0.0001f);
+    Q16_t acc;
+
+    // out of range products and quotients clamp instead of wrapping
+    TEST_ASSERT_EQUAL_INT32(INT32_MAX, (big * Q16_t(2.0f)).bits());
+    TEST_ASSERT_EQUAL_INT32(INT32_MIN, (-big * Q16_t(2.0f)).bits());
+    TEST_ASSERT_EQUAL_INT32(INT32_MAX, (big / tiny).bits());
+    TEST_ASSERT_EQUAL_INT32(INT32_MIN, (-big / tiny).bits());
+    TEST_ASSERT_EQUAL_INT32(INT32_MAX, (big / Q16_t()).bits());
+
+    // so do sums and negation
+    TEST_ASSERT_EQUAL_INT32(INT32_MAX, (big + big).bits());
+    TEST_ASSERT_EQUAL_INT32(INT32_MIN, (-big - big).bits());
+    TEST_ASSERT_EQUAL_INT32(INT32_MAX, (-Q16_t::fromBits(INT32_MIN)).bits());
+    acc = big;
+    acc += big;
+    TEST_ASSERT_EQUAL_INT32(INT32_MAX, acc.bits());
+    acc = -big;
+    acc -= big;
+    TEST_ASSERT_EQUAL_INT32(INT32_MIN, acc.bits());
+
+    // in range stays exact
+    TEST_ASSERT_EQUAL_FLOAT(-7.5f, (float)(Q16_t(3.0f) * Q16_t(-2.5f)));
+    TEST_ASSERT_EQUAL_FLOAT(-3.5f, (float)(Q16_t(7.0f) / Q16_t(-2.0f)));
+    TEST_ASSERT_EQUAL_FLOAT(-1.25f, (float)(Q16_t(1.25f) - Q16_t(2.5f)));
+}
+
+static void test_math_bounds(void)
+{
+    float worstAtan = 0;
+    float worstSqrt = 0;
+    float y, x, v;
+
+    for (int i = -100; i <= 100; i++)
+    {
+        for (int j = -100; j <= 100; j++)
+        {
+            y = i * 0.37f;
+            x = j * 0.41f;
+            worstAtan = fmaxf(worstAtan, 
+                fabsf((float)atan2(Q16_t(y), Q16_t(x)) - atan2f(y, x)));
+        }
+        v = (i + 101) * 1.7f;
+        worstSqrt = fmaxf(worstSqrt, 
+            fabsf((float)sqrt(Q16_t(v)) - sqrtf(v)) / sqrtf(v));
+    }
+
+    // documented bound of the first octant polynomial
+    TEST_ASSERT_LESS_THAN_FLOAT(0.0040f, worstAtan);
+    TEST_ASSERT_LESS_THAN_FLOAT(1e-4f, worstSqrt);
+}
+
+static void test_replay_sample(void)
+{
+    SensorReplay replay(TRACE_PATH, FLTR_TAU, 0.0, 0.0, logger);
+    FusionTilt tilt(FLTR_TAU);
+    FusionTiltQ tiltQ(Q16_t(FLTR_TAU));
+    FusionHeading heading(0.0, 0.0);
+    FusionHeadingQ headingQ(0.0, 0.0);
+    sMARGBatch_t batch;
+    sMARG_t in, marg;
+    sMARGQ_t margQ;
+    float worstTilt = 0;
+    float worstHeading = 0;
+    float dt;
+    uint32_t last_us = 0;
+    uint32_t count;
+
+    replay.init(0);
+    TEST_ASSERT_EQUAL_UINT32(TRACE_LEN, replay.size());
+
+    // one sample at a time, dt from the trace timestamps
+    while (0 < (count = replay.getEvents(&batch, 1)))
+    {
+        for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+        {
+            in.gyro.v[u8_k] = batch.gyro[u8_k][0];
+            in.accl.v[u8_k] = batch.accl[u8_k][0];
+            in.magn.v[u8_k] = batch.magn[u8_k][0];
+        }
+        dt = (0 == last_us) ? 0.0f : (batch.t_us[0] - last_us) * 1e-6f;
+        last_us = batch.t_us[0];
+
+        quantize(&in, &marg, &margQ);
+        tilt.update(&marg, dt);
+        tiltQ.update(&margQ, Q16_t(dt));
+        heading.update(&marg);
+        headingQ.update(&margQ);
+
+        worstTilt = fmaxf(worstTilt, fabsf(tilt.getTilt().roll - 
+                                           (float)tiltQ.getTilt().roll));
+        worstTilt = fmaxf(worstTilt, fabsf(tilt.getTilt().pitch - 
+                                           (float)tiltQ.getTilt().pitch));
+        worstHeading = fmaxf(worstHeading, 
+            angleDiff(heading.getHeading(), (float)headingQ.getHeading()));
+    }
+
+    TEST_ASSERT_LESS_THAN_FLOAT(EQ_TILT, worstTilt);
+    TEST_ASSERT_LESS_THAN_FLOAT(EQ_HEADING, worstHeading);
+}
+
+static void test_replay_batch(void)
+{
+    SensorReplay replay(TRACE_PATH, FLTR_TAU, 0.0, 0.0, logger);
+    FusionTilt tilt(FLTR_TAU);
+    FusionTiltQ tiltQ(Q16_t(FLTR_TAU));
+    sMARGBatch_t batch;
+    sMARGBatchQ_t batchQ;
+    sMARG_t in, marg;
+    sMARGQ_t margQ;
+    float worstTilt = 0;
+    uint32_t count;
+
+    replay.init(0);
+
+    // FIFO sized bursts through the struct of arrays path
+    while (0 < (count = replay.getEvents(&batch, 16)))
+    {
+        for (uint32_t u32_i = 0; u32_i < count; u32_i++)
+        {
+            for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+            {
+                in.gyro.v[u8_k] = batch.gyro[u8_k][u32_i];
+                in.accl.v[u8_k] = batch.accl[u8_k][u32_i];
+                in.magn.v[u8_k] = batch.magn[u8_k][u32_i];
+            }
+            quantize(&in, &marg, &margQ);
+
+            batchQ.t_us[u32_i] = batch.t_us[u32_i];
+            batchQ.gyro[0][u32_i] = margQ.gyro.x;
+            batchQ.gyro[1][u32_i] = margQ.gyro.y;
+            batchQ.gyro[2][u32_i] = margQ.gyro.z;
+            batchQ.accl[0][u32_i] = margQ.accl.x;
+            batchQ.accl[1][u32_i] = margQ.accl.y;
+            batchQ.accl[2][u32_i] = margQ.accl.z;
+            for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+            {
+                batch.gyro[u8_k][u32_i] = marg.gyro.v[u8_k];
+                batch.accl[u8_k][u32_i] = marg.accl.v[u8_k];
+            }
+        }
+        tilt.update(&batch, count);
+        tiltQ.update(&batchQ, count);
+
+        worstTilt = fmaxf(worstTilt, fabsf(tilt.getTilt().roll - 
+                                           (float)tiltQ.getTilt().roll));
+        worstTilt = fmaxf(worstTilt, fabsf(tilt.getTilt().pitch - 
+                                           (float)tiltQ.getTilt().pitch));
+    }
+
+    TEST_ASSERT_LESS_THAN_FLOAT(EQ_TILT, worstTilt);
+}
+
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    if (!writeTrace(TRACE_PATH, TRACE_LEN, TRACE_US))
+    {
+        return 1;
+    }
+
+    UNITY_BEGIN();
+    RUN_TEST(test_saturate);
+    RUN_TEST(test_math_bounds);
+    RUN_TEST(test_replay_sample);
+    RUN_TEST(test_replay_batch);
+    remove(TRACE_PATH);
+    return UNITY_END();
+}
@@ -0,0 +1,102 @@
+#include <unity.h>
+#include <math.h>
+#include "Fusion/FusionBias.h"
+
+/* private macros ------------------------------------------------------------*/
+#define BLOCK_LEN       50
+#define GYRO_BIAS       0.02        // [rad/s]
+#define ACCL_BIAS       0.3         // [m/s^2] on x
+
+/* private variables ---------------------------------------------------------*/
+static FusionBias bias;
+
+/* private functions ---------------------------------------------------------*/
+// one block of constant readings, bias added like the chip does
+static bool feed(float gx, float gy, float gz, float ax, float ay, float az)
+{
+    sensors_vec_t gyro;
+    sensors_vec_t accl;
+    bool still = false;
+
+    gyro.x = gx + GYRO_BIAS;
+    gyro.y = gy + GYRO_BIAS;
+    gyro.z = gz + GYRO_BIAS;
+    accl.x = ax + ACCL_BIAS;
+    accl.y = ay;
+    accl.z = az;
+    for (uint32_t u32_i = 0; u32_i < BLOCK_LEN; u32_i++)
+    {
+        still = bias.update(&gyro, &accl);
+    }
+    return still;
+}
+
+void setUp(void)
+{
+    // fresh estimator, nothing learned
+    bias = FusionBias();
+    bias.begin(BLOCK_LEN);
+}
+
+void tearDown(void)
+{
+}
+
+void test_level_still(void)
+{
+    TEST_ASSERT_TRUE(feed(0, 0, 0, 0, 0, SENSORS_GRAVITY_STANDARD));
+    TEST_ASSERT_TRUE(bias.isValid());
+    TEST_ASSERT_TRUE(bias.isLevel());
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, GYRO_BIAS, bias.getGyro().z);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, ACCL_BIAS, bias.getAccl().x);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, 0, bias.getAccl().z);
+}
+
+void test_steady_rotation(void)
+{
+    // range is flat but the mean is far beyond any zero rate offset
+    TEST_ASSERT_FALSE(feed(0, 0, 1.0, 0, 0, SENSORS_GRAVITY_STANDARD));
+    TEST_ASSERT_FALSE(bias.isValid());
+
+    // once known, a slow turn is still too far from the bias
+    TEST_ASSERT_TRUE(feed(0, 0, 0, 0, 0, SENSORS_GRAVITY_STANDARD));
+    TEST_ASSERT_FALSE(feed(0, 0, 0.2, 0, 0, SENSORS_GRAVITY_STANDARD));
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, GYRO_BIAS, bias.getGyro().z);
+}
+
+void test_constant_accel(void)
+{
+    // free fall like and pushed blocks are not gravity
+    TEST_ASSERT_FALSE(feed(0, 0, 0, 0, 0, 0.5 * SENSORS_GRAVITY_STANDARD));
+    TEST_ASSERT_FALSE(feed(0, 0, 0, 5.0, 0, SENSORS_GRAVITY_STANDARD));
+    TEST_ASSERT_FALSE(bias.isValid());
+}
+
+void test_tilted_still(void)
+{
+    float g = SENSORS_GRAVITY_STANDARD;
+
+    // gyro learns, accel waits for a flat block
+    TEST_ASSERT_TRUE(feed(0, 0, 0, g * sinf(0.5), 0, g * cosf(0.5)));
+    TEST_ASSERT_FALSE(bias.isLevel());
+    TEST_ASSERT_FALSE(bias.isValid());
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, GYRO_BIAS, bias.getGyro().x);
+
+    TEST_ASSERT_TRUE(feed(0, 0, 0, 0, 0, g));
+    TEST_ASSERT_TRUE(bias.isLevel());
+    TEST_ASSERT_TRUE(bias.isValid());
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, ACCL_BIAS, bias.getAccl().x);
+}
+
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_level_still);
+    RUN_TEST(test_steady_rotation);
+    RUN_TEST(test_constant_accel);
+    RUN_TEST(test_tilted_still);
+    return UNITY_END();
+}
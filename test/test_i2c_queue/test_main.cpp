@@ -0,0 +1,298 @@
+#include <unity.h>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include "Bus/I2CBusMock.h"
+#include "Bus/I2CQueue.h"
+#include "Sensor/HMCAsync.h"
+
+/* private macros ------------------------------------------------------------*/
+#define DEV_A           0x68
+#define DEV_B           0x1E
+#define DEV_NONE        0x50
+#define SUBMITTERS      4
+#define XACTS           200
+
+/* private typedef -----------------------------------------------------------*/
+// backend held shut by the test to fill the queue up
+class GateBus : public I2CBus {
+public:
+    GateBus(I2CBus& bus) : mBus{bus}, mOpen{true}, mHeld{0} {};
+
+    bool read(uint8_t dev, uint8_t reg, uint8_t len, uint8_t* p_data) override
+    {
+        pass();
+        return mBus.read(dev, reg, len, p_data);
+    }
+
+    bool write(uint8_t dev, uint8_t reg, uint8_t len, 
+               const uint8_t* p_data) override
+    {
+        pass();
+        return mBus.write(dev, reg, len, p_data);
+    }
+
+    void set(bool open)
+    {
+        {
+            std::lock_guard<std::mutex> guard(mLock);
+            mOpen = open;
+        }
+        mCond.notify_all();
+    }
+
+    // transfers which reached the backend while it was shut
+    uint32_t getHeld() const
+    {
+        return mHeld;
+    }
+
+private:
+    I2CBus& mBus;
+    std::mutex mLock;
+    std::condition_variable mCond;
+    bool mOpen;
+    std::atomic<uint32_t> mHeld;
+
+    void pass()
+    {
+        std::unique_lock<std::mutex> guard(mLock);
+
+        mHeld += mOpen ? 0 : 1;
+        mCond.wait(guard, [this] { return mOpen; });
+    }
+};
+
+typedef struct
+{
+    std::atomic<uint32_t> count;
+    std::atomic<uint32_t> failed;
+    std::atomic<uint32_t> order;    // completions seen out of submit order
+    uint32_t next;
+} sDone_t;
+
+/* private variables ---------------------------------------------------------*/
+static I2CBusMock mock;
+static GateBus gate(mock);
+
+/* private functions ---------------------------------------------------------*/
+static void onDone(void* p_arg, bool ok)
+{
+    sDone_t* p_done = (sDone_t*)p_arg;
+    uint32_t count = p_done->count.fetch_add(1);
+
+    p_done->failed += ok ? 0 : 1;
+    p_done->order += (count == p_done->next++) ? 0 : 1;
+}
+
+static void resetDone(sDone_t* p_done)
+{
+    p_done->count = 0;
+    p_done->failed = 0;
+    p_done->order = 0;
+    p_done->next = 0;
+}
+
+void setUp(void)
+{
+    mock = I2CBusMock();
+    mock.attach(DEV_A);
+    mock.attach(DEV_B);
+    gate.set(true);
+}
+
+void tearDown(void)
+{
+}
+
+void test_blocking(void)
+{
+    I2CQueue queue(gate);
+    uint8_t data[2] = { 0x12, 0x34 };
+
+    // existing drivers keep the I2CBus calls
+    queue.begin();
+    TEST_ASSERT_TRUE(queue.write(DEV_A, 0x10, 2, data));
+    data[0] = data[1] = 0;
+    TEST_ASSERT_TRUE(queue.read(DEV_A, 0x10, 2, data));
+    TEST_ASSERT_EQUAL_HEX8(0x12, data[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x34, data[1]);
+    TEST_ASSERT_FALSE(queue.read(DEV_NONE, 0x00, 1, data));
+    queue.end();
+
+    TEST_ASSERT_EQUAL_UINT32(3, mock.getLog().size());
+    TEST_ASSERT_TRUE(mock.getLog()[0].write);
+    TEST_ASSERT_FALSE(mock.getLog()[1].write);
+}
+
+void test_async_order(void)
+{
+    I2CQueue queue(gate);
+    static uint8_t buf[XACTS];
+    sDone_t done;
+
+    // submitter goes on, callbacks come in submit order
+    resetDone(&done);
+    queue.begin();
+    for (uint32_t u32_i = 0; u32_i < XACTS; u32_i++)
+    {
+        // every 7th one nacks
+        uint8_t dev = (0 == (u32_i % 7)) ? DEV_NONE : DEV_B;
+        sI2CXact_t xact = { dev, (uint8_t)u32_i, 1, false, &buf[u32_i], 
+                            onDone, &done };
+
+        while (!queue.submit(&xact))
+        {
+            std::this_thread::yield();
+        }
+    }
+    queue.end();
+
+    TEST_ASSERT_EQUAL_UINT32(XACTS, done.count.load());
+    TEST_ASSERT_EQUAL_UINT32(0, done.order.load());
+    TEST_ASSERT_EQUAL_UINT32((XACTS + 6) / 7, done.failed.load());
+    for (uint32_t u32_i = 0; u32_i < XACTS; u32_i++)
+    {
+        TEST_ASSERT_EQUAL_UINT8(u32_i, mock.getLog()[u32_i].reg);
+    }
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(I2C_QUEUE_LEN, queue.getHighWater());
+}
+
+void test_full(void)
+{
+    I2CQueue queue(gate);
+    uint8_t buf;
+    sDone_t done;
+    sI2CXact_t xact = { DEV_A, 0x00, 1, false, &buf, onDone, &done };
+    uint32_t accepted = 0;
+    uint32_t held = gate.getHeld();
+
+    // worker stuck on the first transfer, the rest fills the slots
+    resetDone(&done);
+    gate.set(false);
+    queue.begin();
+    TEST_ASSERT_TRUE(queue.submit(&xact));
+    while (held == gate.getHeld())
+    {
+        std::this_thread::yield();
+    }
+    while (queue.submit(&xact))
+    {
+        accepted++;
+    }
+    TEST_ASSERT_EQUAL_UINT32(I2C_QUEUE_LEN, accepted);
+    TEST_ASSERT_EQUAL_UINT32(I2C_QUEUE_LEN, queue.getHighWater());
+
+    // everything queued still runs before end() returns
+    gate.set(true);
+    queue.end();
+    TEST_ASSERT_EQUAL_UINT32(1 + I2C_QUEUE_LEN, done.count.load());
+    TEST_ASSERT_FALSE(queue.submit(&xact));
+}
+
+void test_submitters(void)
+{
+    I2CQueue queue(gate);
+    std::thread tasks[SUBMITTERS];
+    std::atomic<uint32_t> errors(0);
+
+    // each task owns one register, blocking calls never mix their data
+    queue.begin();
+    for (uint8_t u8_k = 0; u8_k < SUBMITTERS; u8_k++)
+    {
+        tasks[u8_k] = std::thread([&queue, &errors, u8_k] {
+            uint8_t val;
+
+            for (uint32_t u32_i = 0; u32_i < XACTS; u32_i++)
+            {
+                val = (uint8_t)(u32_i + u8_k);
+                errors += queue.write(DEV_A, u8_k, 1, &val) ? 0 : 1;
+                val = 0xFF;
+                errors += queue.read(DEV_A, u8_k, 1, &val) ? 0 : 1;
+                errors += ((uint8_t)(u32_i + u8_k) == val) ? 0 : 1;
+            }
+        });
+    }
+    for (uint8_t u8_k = 0; u8_k < SUBMITTERS; u8_k++)
+    {
+        tasks[u8_k].join();
+    }
+    queue.end();
+
+    TEST_ASSERT_EQUAL_UINT32(0, errors.load());
+    TEST_ASSERT_EQUAL_UINT32(2 * SUBMITTERS * XACTS, mock.getLog().size());
+}
+
+void test_hmc_async(void)
+{
+    I2CQueue queue(gate);
+    HMCAsync hmc(queue);
+    sensors_vec_t magn;
+
+    mock.setReg(DEV_B, HMC_ID_A + 0, 'H');
+    mock.setReg(DEV_B, HMC_ID_A + 1, '4');
+    mock.setReg(DEV_B, HMC_ID_A + 2, '3');
+    mock.setReg(DEV_B, HMC_DATA_X_H + 0, 0x04);     // X  1100
+    mock.setReg(DEV_B, HMC_DATA_X_H + 1, 0x4C);
+    mock.setReg(DEV_B, HMC_DATA_X_H + 2, 0xFC);     // Z  -980
+    mock.setReg(DEV_B, HMC_DATA_X_H + 3, 0x2C);
+    mock.setReg(DEV_B, HMC_DATA_X_H + 4, 0xFD);     // Y  -550
+    mock.setReg(DEV_B, HMC_DATA_X_H + 5, 0xDA);
+
+    queue.begin();
+    hmc.begin();
+    TEST_ASSERT_EQUAL_HEX8(HMC_GAIN_1_3GA, mock.getReg(DEV_B, HMC_CONFIG_B));
+    TEST_ASSERT_EQUAL_HEX8(HMC_CONTINUOUS, mock.getReg(DEV_B, HMC_MODE));
+
+    // the caller never waits, nothing landed yet
+    gate.set(false);
+    TEST_ASSERT_FALSE(hmc.read(&magn));
+    TEST_ASSERT_FALSE(hmc.read(&magn));
+    gate.set(true);
+
+    for (uint32_t u32_i = 0; (u32_i < 100) && !hmc.read(&magn); u32_i++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    queue.end();
+
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 100.0, magn.x);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, -50.0, magn.y);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, -100.0, magn.z);
+    TEST_ASSERT_EQUAL_UINT32(0, hmc.getErrors());
+}
+
+void test_hmc_missing(void)
+{
+    I2CQueue queue(gate);
+    HMCAsync hmc(queue);
+    const char* p_error = nullptr;
+
+    // id reads back zeros
+    queue.begin();
+    try
+    {
+        hmc.begin();
+    }
+    catch (const char* error)
+    {
+        p_error = error;
+    }
+    queue.end();
+    TEST_ASSERT_EQUAL_STRING("HMC5883L error\n", p_error);
+}
+
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_blocking);
+    RUN_TEST(test_async_order);
+    RUN_TEST(test_full);
+    RUN_TEST(test_submitters);
+    RUN_TEST(test_hmc_async);
+    RUN_TEST(test_hmc_missing);
+    return UNITY_END();
+}
@@ -0,0 +1,173 @@
+#include <unity.h>
+#include <math.h>
+#include <random>
+#include "Fusion/FusionMagFit.h"
+
+/* private macros ------------------------------------------------------------*/
+#define FIELD           48.0        // [uT]
+#define NOISE           0.2         // [uT] rms per axis
+#define SAMPLES         3000
+#define STILL_SAMPLES   2000
+
+#define EQ_OFFSET       1.0         // [uT]
+#define EQ_SPREAD       0.05        // corrected field, (max - min) / mean
+
+/* private variables ---------------------------------------------------------*/
+static const float offset[3] = { 30.0, -20.0, 15.0 };
+
+// soft iron, axes 1.15 / 0.9 / 1.0 turned 30 deg about z and 20 deg about x
+static Matrix<3, 3> softIron;
+
+static std::mt19937 rng;
+static std::normal_distribution<float> noise(0.0f, 1.0f);
+
+/* private functions ---------------------------------------------------------*/
+static Matrix<3, 3> rotation(uint8_t axis, float angle)
+{
+    Matrix<3, 3> R = Matrix<3, 3>::identity();
+    uint8_t a = (axis + 1) % 3;
+    uint8_t b = (axis + 2) % 3;
+
+    R(a, a) = cosf(angle);
+    R(a, b) = -sinf(angle);
+    R(b, a) = sinf(angle);
+    R(b, b) = cosf(angle);
+    return R;
+}
+
+// field along unit vector u as the distorted sensor reads it
+static sensors_vec_t sample(const float u[3])
+{
+    sensors_vec_t magn;
+
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        magn.v[i] = offset[i] + NOISE * noise(rng);
+        for (uint8_t j = 0; j < 3; j++)
+        {
+            magn.v[i] += softIron(i, j) * FIELD * u[j];
+        }
+    }
+    return magn;
+}
+
+// uniform direction on the sphere
+static void direction(float u[3])
+{
+    float n;
+
+    do
+    {
+        n = 0;
+        for (uint8_t i = 0; i < 3; i++)
+        {
+            u[i] = noise(rng);
+            n += u[i] * u[i];
+        }
+    } while (1e-6 > n);
+
+    n = sqrtf(n);
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        u[i] /= n;
+    }
+}
+
+void setUp(void)
+{
+    Matrix<3, 3> Q;
+    Matrix<3, 3> D;
+
+    Q = rotation(2, 30 * M_PI / 180) * rotation(0, 20 * M_PI / 180);
+    D(0, 0) = 1.15;
+    D(1, 1) = 0.9;
+    D(2, 2) = 1.0;
+    softIron = Q * D * Q.transpose();
+
+    rng.seed(1);
+}
+
+void tearDown(void)
+{
+}
+
+void test_tumble(void)
+{
+    FusionMagFit fit;
+    sensors_vec_t magn;
+    float u[3];
+    float norm, lo = 1e9, hi = 0, sum = 0;
+
+    // turned through every orientation
+    for (uint32_t u32_i = 0; u32_i < SAMPLES; u32_i++)
+    {
+        direction(u);
+        magn = sample(u);
+        fit.update(&magn);
+    }
+    TEST_ASSERT_TRUE(fit.isValid());
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        TEST_ASSERT_FLOAT_WITHIN(EQ_OFFSET, offset[i], fit.getOffset().v[i]);
+    }
+
+    // corrected field lies on a sphere
+    for (uint32_t u32_i = 0; u32_i < SAMPLES; u32_i++)
+    {
+        direction(u);
+        magn = sample(u);
+        fit.correct(&magn);
+        norm = sqrtf(magn.x * magn.x + magn.y * magn.y + magn.z * magn.z);
+        lo = fminf(lo, norm);
+        hi = fmaxf(hi, norm);
+        sum += norm;
+    }
+    TEST_ASSERT_TRUE(EQ_SPREAD > (hi - lo) / (sum / SAMPLES));
+}
+
+void test_still(void)
+{
+    FusionMagFit fit;
+    sensors_vec_t magn;
+    const float u[3] = { 0.5, 0.0, 0.866 };
+
+    // no rotation, the prior must not pass for a fit
+    for (uint32_t u32_i = 0; u32_i < STILL_SAMPLES; u32_i++)
+    {
+        magn = sample(u);
+        fit.update(&magn);
+        TEST_ASSERT_FALSE(fit.isValid());
+    }
+}
+
+void test_level_turn(void)
+{
+    FusionMagFit fit;
+    sensors_vec_t magn;
+    float u[3];
+
+    // flat on the table, z never sweeps
+    for (uint32_t u32_i = 0; u32_i < SAMPLES; u32_i++)
+    {
+        float yaw = 2 * M_PI * u32_i / 500;
+
+        u[0] = 0.5 * cosf(yaw);
+        u[1] = 0.5 * sinf(yaw);
+        u[2] = 0.866;
+        magn = sample(u);
+        fit.update(&magn);
+    }
+    TEST_ASSERT_FALSE(fit.isValid());
+}
+
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_tumble);
+    RUN_TEST(test_still);
+    RUN_TEST(test_level_turn);
+    return UNITY_END();
+}
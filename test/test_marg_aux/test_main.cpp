@@ -0,0 +1,329 @@
+#include <unity.h>
+#include <string.h>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include "Bus/I2CBusMock.h"
+#include "Bus/I2CQueue.h"
+#include "Sensor/MARGAux.h"
+#include "Sensor/HMC5883Regs.h"
+#include "Sensor/SensorMagnet.h"
+#include "Sensor/SensorPair.h"
+
+/* private macros ------------------------------------------------------------*/
+#define MPU_EXT_SENS_DATA   0x49
+#define MPU_NONE            0xFF    // past the last register
+#define NACK_STEPS          20
+#define READ_TRIES          100
+
+/* private typedef -----------------------------------------------------------*/
+typedef struct
+{
+    uint8_t dev;
+    uint8_t reg;
+    bool write;
+    uint8_t data;
+} sStep_t;
+
+// MPU6050 reads nack while set, writes to one MPU6050 register may nack
+class NackBus : public I2CBus {
+public:
+    NackBus(I2CBus& bus) : mBus{bus}, mNack{false}, mFailReg{MPU_NONE} {};
+
+    bool read(uint8_t dev, uint8_t reg, uint8_t len, uint8_t* p_data) override
+    {
+        if (mNack && (MPU_ADDR == dev))
+        {
+            return false;
+        }
+        return mBus.read(dev, reg, len, p_data);
+    }
+
+    bool write(uint8_t dev, uint8_t reg, uint8_t len, 
+               const uint8_t* p_data) override
+    {
+        if ((MPU_ADDR == dev) && (mFailReg == reg))
+        {
+            return false;
+        }
+        return mBus.write(dev, reg, len, p_data);
+    }
+
+    void set(bool nack)
+    {
+        mNack = nack;
+    }
+
+    // writes to one MPU6050 register nack
+    void failWrite(uint8_t reg)
+    {
+        mFailReg = reg;
+    }
+
+private:
+    I2CBus& mBus;
+    std::atomic<bool> mNack;
+    uint8_t mFailReg;
+};
+
+// SensorFUSE getEvent with USE_AUXMAG, without the bias compensation
+class AuxImu {
+public:
+    AuxImu(I2CBus& bus) : mAux{bus} {};
+
+    void init(uint32_t count)
+    {
+        (void)count;
+    }
+
+    bool getEvent(sMARG_t* p_marg)
+    {
+        sMARGRaw_t raw;
+
+        if (!mAux.read(&raw))
+        {
+            return false;
+        }
+        MARGAux::toMARG(&raw, p_marg);
+        return true;
+    }
+
+private:
+    MARGAux mAux;
+};
+
+/* private variables ---------------------------------------------------------*/
+// bypass to set the HMC5883 up, then slave 0 of the MPU6050 master reads
+// its six data bytes into EXT_SENS_DATA
+static const sStep_t beginSeq[] = {
+    { MPU_ADDR, MPU_GYRO_CONFIG,    true,  0x00 },
+    { MPU_ADDR, MPU_ACCEL_CONFIG,   true,  0x00 },
+    { MPU_ADDR, MPU_USER_CTRL,      true,  0x00 },
+    { MPU_ADDR, MPU_INT_PIN_CFG,    true,  0x02 },
+    { HMC_ADDR, HMC_ID_A,           false, 'H'  },
+    { HMC_ADDR, HMC_CONFIG_A,       true,  HMC_RATE_75HZ },
+    { HMC_ADDR, HMC_CONFIG_B,       true,  HMC_GAIN_1_3GA },
+    { HMC_ADDR, HMC_MODE,           true,  HMC_CONTINUOUS },
+    { MPU_ADDR, MPU_INT_PIN_CFG,    true,  0x00 },
+    { MPU_ADDR, MPU_I2C_MST_CTRL,   true,  0x40 | 13 },
+    { MPU_ADDR, MPU_I2C_SLV0_ADDR,  true,  0x80 | HMC_ADDR },
+    { MPU_ADDR, MPU_I2C_SLV0_REG,   true,  HMC_DATA_X_H },
+    { MPU_ADDR, MPU_I2C_SLV0_CTRL,  true,  0x80 | HMC_DATA_LEN },
+    { MPU_ADDR, MPU_USER_CTRL,      true,  0x20 },
+};
+
+/* private functions ---------------------------------------------------------*/
+static void attachHMC(I2CBusMock* p_bus)
+{
+    p_bus->attach(HMC_ADDR);
+    p_bus->setReg(HMC_ADDR, HMC_ID_A + 0, 'H');
+    p_bus->setReg(HMC_ADDR, HMC_ID_A + 1, '4');
+    p_bus->setReg(HMC_ADDR, HMC_ID_A + 2, '3');
+}
+
+static void setWord(I2CBusMock* p_bus, uint8_t reg, int16_t val)
+{
+    p_bus->setReg(MPU_ADDR, reg + 0, (uint8_t)((uint16_t)val >> 8));
+    p_bus->setReg(MPU_ADDR, reg + 1, (uint8_t)val);
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_begin_sequence(void)
+{
+    I2CBusMock bus;
+    MARGAux aux(bus);
+
+    bus.attach(MPU_ADDR);
+    attachHMC(&bus);
+    aux.begin();
+
+    const std::vector<sI2CXfer_t>& log = bus.getLog();
+    TEST_ASSERT_EQUAL_UINT32(sizeof(beginSeq) / sizeof(sStep_t), log.size());
+    for (uint32_t u32_i = 0; u32_i < log.size(); u32_i++)
+    {
+        TEST_ASSERT_EQUAL_HEX8(beginSeq[u32_i].dev, log[u32_i].dev);
+        TEST_ASSERT_EQUAL_HEX8(beginSeq[u32_i].reg, log[u32_i].reg);
+        TEST_ASSERT_EQUAL(beginSeq[u32_i].write, log[u32_i].write);
+        TEST_ASSERT_EQUAL_HEX8(beginSeq[u32_i].data, log[u32_i].data[0]);
+    }
+
+    // master left running on slave 0
+    TEST_ASSERT_EQUAL_HEX8(0x80 | HMC_ADDR, 
+                           bus.getReg(MPU_ADDR, MPU_I2C_SLV0_ADDR));
+    TEST_ASSERT_EQUAL_HEX8(0x20, bus.getReg(MPU_ADDR, MPU_USER_CTRL));
+}
+
+void test_missing_hmc(void)
+{
+    I2CBusMock bus;
+    MARGAux aux(bus);
+    const char* p_error = nullptr;
+
+    bus.attach(MPU_ADDR);
+    try
+    {
+        aux.begin();
+    }
+    catch (const char* error)
+    {
+        p_error = error;
+    }
+    TEST_ASSERT_NOT_NULL(p_error);
+    TEST_ASSERT_EQUAL_STRING("HMC5883L error\n", p_error);
+}
+
+void test_begin_write_fail(void)
+{
+    static const uint8_t setupRegs[] = {
+        MPU_GYRO_CONFIG, MPU_INT_PIN_CFG, MPU_I2C_MST_CTRL, 
+        MPU_I2C_SLV0_ADDR, MPU_I2C_SLV0_CTRL
+    };
+
+    // master must not be left half set up on slave 0
+    for (uint8_t u8_k = 0; u8_k < sizeof(setupRegs); u8_k++)
+    {
+        I2CBusMock mock;
+        NackBus bus(mock);
+        MARGAux aux(bus);
+        const char* p_error = nullptr;
+
+        mock.attach(MPU_ADDR);
+        attachHMC(&mock);
+        bus.failWrite(setupRegs[u8_k]);
+        try
+        {
+            aux.begin();
+        }
+        catch (const char* error)
+        {
+            p_error = error;
+        }
+        TEST_ASSERT_NOT_NULL(p_error);
+        TEST_ASSERT_EQUAL_STRING("MPU6050 error\n", p_error);
+    }
+}
+
+void test_read_burst(void)
+{
+    I2CBusMock bus;
+    MARGAux aux(bus);
+    sMARGRaw_t raw;
+    sMARG_t marg;
+
+    // 1g on z, 1 dps on x, 0 degC, HMC order X, Z, Y
+    bus.attach(MPU_ADDR);
+    setWord(&bus, MPU_ACCEL_XOUT_H + 4, 16384);
+    setWord(&bus, MPU_TEMP_OUT_H, -12420);
+    setWord(&bus, MPU_TEMP_OUT_H + 2, 131);
+    setWord(&bus, MPU_EXT_SENS_DATA + 0, 1100);
+    setWord(&bus, MPU_EXT_SENS_DATA + 2, -980);
+    setWord(&bus, MPU_EXT_SENS_DATA + 4, -550);
+
+    // one transaction for all nine axes
+    bus.clearLog();
+    TEST_ASSERT_TRUE(aux.read(&raw));
+    TEST_ASSERT_EQUAL_UINT32(1, bus.getLog().size());
+    TEST_ASSERT_EQUAL_HEX8(MPU_ACCEL_XOUT_H, bus.getLog()[0].reg);
+    TEST_ASSERT_EQUAL_UINT8(20, bus.getLog()[0].len);
+
+    TEST_ASSERT_EQUAL_INT16(16384, raw.accl[2]);
+    TEST_ASSERT_EQUAL_INT16(131, raw.gyro[0]);
+    TEST_ASSERT_EQUAL_INT16(1100, raw.magn[0]);
+    TEST_ASSERT_EQUAL_INT16(-550, raw.magn[1]);
+    TEST_ASSERT_EQUAL_INT16(-980, raw.magn[2]);
+
+    MARGAux::toMARG(&raw, &marg);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, SENSORS_GRAVITY_STANDARD, marg.accl.z);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, SENSORS_DPS_TO_RADS, marg.gyro.x);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 100.0, marg.magn.x);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, -50.0, marg.magn.y);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, -100.0, marg.magn.z);
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 0.0, MARGAux::toTemp(&raw));
+}
+
+void test_read_nack(void)
+{
+    I2CBusMock bus;
+    MARGAux aux(bus);
+    sMARGRaw_t raw;
+
+    // caller keeps its last sample
+    TEST_ASSERT_FALSE(aux.read(&raw));
+}
+
+void test_pair_nack(void)
+{
+    I2CBusMock mock;
+    NackBus bus(mock);
+    I2CQueue queue(bus);
+    SensorLogger logger(stdout);
+    AuxImu imu(queue);
+    SensorMagnet magn(queue, 0.0, 0.0, logger);
+    SensorPair<AuxImu, SensorMagnet> pair(imu, magn);
+    sCalibBlob_t calib;
+    sMARG_t marg;
+    bool ok = false;
+
+    mock.attach(MPU_ADDR);
+    mock.attach(HMC_ADDR);
+    mock.setReg(HMC_ADDR, HMC_ID_A + 0, 'H');
+    mock.setReg(HMC_ADDR, HMC_ID_A + 1, '4');
+    mock.setReg(HMC_ADDR, HMC_ID_A + 2, '3');
+    mock.setReg(HMC_ADDR, HMC_DATA_X_H + 0, 0x04);  // X 1100, 100 uT
+    mock.setReg(HMC_ADDR, HMC_DATA_X_H + 1, 0x4C);
+
+    queue.begin();
+    pair.init(0);
+
+    // a failed burst leaves the corrected field in place, the magnetometer 
+    // stage must not take it for a raw one
+    bus.set(true);
+    memset(&marg, 0x0, sizeof(sMARG_t));
+    marg.magn.x = 12.5;
+    for (uint32_t u32_i = 0; u32_i < NACK_STEPS; u32_i++)
+    {
+        TEST_ASSERT_FALSE(pair.getEvent(&marg));
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    TEST_ASSERT_EQUAL_FLOAT(12.5, marg.magn.x);
+    TEST_ASSERT_TRUE(magn.getCalib(&calib));
+    TEST_ASSERT_EQUAL_FLOAT(1e9, calib.rangeMagn[0][0]);
+    TEST_ASSERT_EQUAL_FLOAT(-1e9, calib.rangeMagn[0][1]);
+
+    // range follows again once the bus recovers
+    bus.set(false);
+    for (uint32_t u32_i = 0; (u32_i < READ_TRIES) && !ok; u32_i++)
+    {
+        TEST_ASSERT_TRUE(pair.getEvent(&marg));
+        magn.getCalib(&calib);
+        ok = (1e9 > calib.rangeMagn[0][0]);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    queue.end();
+
+    TEST_ASSERT_TRUE(ok);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 100.0, calib.rangeMagn[0][0]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 100.0, calib.rangeMagn[0][1]);
+}
+
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_begin_sequence);
+    RUN_TEST(test_missing_hmc);
+    RUN_TEST(test_begin_write_fail);
+    RUN_TEST(test_read_burst);
+    RUN_TEST(test_read_nack);
+    RUN_TEST(test_pair_nack);
+    return UNITY_END();
+}
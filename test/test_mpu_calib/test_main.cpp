@@ -0,0 +1,164 @@
+#include <unity.h>
+#include <math.h>
+#include "Sched/ClockSim.h"
+#include "Sensor/MPUSim.h"
+#include "Sensor/MPUCalib.h"
+#include "Sensor/MPU6050Regs.h"
+
+/* private macros ------------------------------------------------------------*/
+#define PERIOD_US       1000        // 1 kHz sample rate, DMP setup
+#define MAX_SAMPLES     2000
+#define NOISE_ACCL      16.0        // [counts] ~1 mg rms
+#define NOISE_GYRO      5.0         // [counts] ~0.04 dps rms
+#define CHECK_SAMPLES   4000
+
+#define EQ_ACCL         2.0         // [mg] CALIB_ACCL_TOL
+#define EQ_GYRO         0.1         // [dps] CALIB_GYRO_TOL
+
+/* private variables ---------------------------------------------------------*/
+static const int16_t biasAccl[3] = { 1200, -840, 410 };
+static const int16_t biasGyro[3] = { 96, -150, 33 };
+
+/* private functions ---------------------------------------------------------*/
+// long average after calibration, what the DMP would start from
+static void measure(I2CBus* p_bus, float* p_accl_mg, float* p_gyro_dps)
+{
+    uint8_t buf[14];
+    float sum[6] = {0};
+
+    for (uint32_t u32_i = 0; u32_i < CHECK_SAMPLES; u32_i++)
+    {
+        p_bus->read(MPU_ADDR, MPU_ACCEL_XOUT_H, sizeof(buf), buf);
+        for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+        {
+            sum[u8_k]     += (int16_t)((buf[2*u8_k] << 8) | buf[2*u8_k + 1]);
+            sum[u8_k + 3] += (int16_t)((buf[2*u8_k + 8] << 8) | 
+                                       buf[2*u8_k + 9]);
+        }
+    }
+
+    sum[2] -= CHECK_SAMPLES * MPU_LSB_G;
+    *p_accl_mg = 0;
+    *p_gyro_dps = 0;
+    for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+    {
+        *p_accl_mg = fmaxf(*p_accl_mg, 
+                           fabsf(sum[u8_k] / CHECK_SAMPLES) * 1000 / MPU_LSB_G);
+        *p_gyro_dps = fmaxf(*p_gyro_dps, 
+                            fabsf(sum[u8_k + 3] / CHECK_SAMPLES) / MPU_LSB_DPS);
+    }
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_converges(void)
+{
+    MPUSim sim(7);
+    ClockSim clock;
+    MPUCalib calib(sim, clock, PERIOD_US);
+    sMPUCalib_t result;
+    float accl_mg;
+    float gyro_dps;
+
+    sim.setBias(biasAccl, biasGyro);
+    sim.setNoise(NOISE_ACCL, NOISE_GYRO);
+    TEST_ASSERT_TRUE(calib.run(MAX_SAMPLES, &result));
+
+    // done well before the budget, the old PID loops always ran it all
+    TEST_ASSERT_TRUE(result.converged);
+    TEST_ASSERT_LESS_THAN_UINT32(MAX_SAMPLES / 4, result.samples);
+    TEST_ASSERT_LESS_THAN_FLOAT(EQ_ACCL, result.residAccl);
+    TEST_ASSERT_LESS_THAN_FLOAT(EQ_GYRO, result.residGyro);
+
+    // offsets at their register scales (16G / 1000DPS)
+    for (uint8_t u8_k = 0; u8_k < 3; u8_k++)
+    {
+        TEST_ASSERT_INT_WITHIN(2, -biasAccl[u8_k] / 8, result.offsAccl[u8_k]);
+        TEST_ASSERT_INT_WITHIN(1, -biasGyro[u8_k] / 4, result.offsGyro[u8_k]);
+    }
+
+    // boot dead time, on virtual time
+    TEST_ASSERT_LESS_THAN_UINT32(MAX_SAMPLES * PERIOD_US / 4, clock.now());
+
+    measure(&sim, &accl_mg, &gyro_dps);
+    TEST_ASSERT_LESS_THAN_FLOAT(EQ_ACCL, accl_mg);
+    TEST_ASSERT_LESS_THAN_FLOAT(EQ_GYRO, gyro_dps);
+}
+
+void test_early_exit(void)
+{
+    MPUSim sim;
+    ClockSim clock;
+    MPUCalib calib(sim, clock, PERIOD_US);
+    sMPUCalib_t result;
+
+    // already calibrated chip: one small batch and one to confirm
+    TEST_ASSERT_TRUE(calib.run(MAX_SAMPLES, &result));
+    TEST_ASSERT_TRUE(result.converged);
+    TEST_ASSERT_EQUAL_UINT16(2, result.iters);
+    TEST_ASSERT_EQUAL_UINT32(8 + 32, result.samples);
+}
+
+void test_budget(void)
+{
+    MPUSim sim(3);
+    ClockSim clock;
+    MPUCalib calib(sim, clock, PERIOD_US);
+    sMPUCalib_t result;
+
+    // noise far above the tolerance never settles, budget is honoured
+    sim.setBias(biasAccl, biasGyro);
+    sim.setNoise(40 * NOISE_ACCL, 40 * NOISE_GYRO);
+    TEST_ASSERT_TRUE(calib.run(MAX_SAMPLES, &result));
+    TEST_ASSERT_FALSE(result.converged);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(MAX_SAMPLES, result.samples);
+    TEST_ASSERT_GREATER_THAN_UINT32(MAX_SAMPLES - 32, result.samples);
+}
+
+void test_reserved_bit(void)
+{
+    MPUSim sim(5);
+    ClockSim clock;
+    MPUCalib calib(sim, clock, PERIOD_US);
+    sMPUCalib_t result;
+
+    // accel offset bit 0 is factory owned, left as found
+    sim.setReg(MPU_ADDR, MPU_XA_OFFS_H + 1, 0x01);
+    sim.setBias(biasAccl, biasGyro);
+    sim.setNoise(NOISE_ACCL, NOISE_GYRO);
+    TEST_ASSERT_TRUE(calib.run(MAX_SAMPLES, &result));
+    TEST_ASSERT_TRUE(result.converged);
+    TEST_ASSERT_EQUAL_INT16(1, result.offsAccl[0] & 1);
+    TEST_ASSERT_EQUAL_INT16(0, result.offsAccl[1] & 1);
+}
+
+void test_bus_error(void)
+{
+    I2CBusMock bus;
+    ClockSim clock;
+    MPUCalib calib(bus, clock, PERIOD_US);
+    sMPUCalib_t result;
+
+    // no MPU6050 on the bus
+    TEST_ASSERT_FALSE(calib.run(MAX_SAMPLES, &result));
+}
+
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_converges);
+    RUN_TEST(test_early_exit);
+    RUN_TEST(test_budget);
+    RUN_TEST(test_reserved_bit);
+    RUN_TEST(test_bus_error);
+    return UNITY_END();
+}
@@ -0,0 +1,141 @@
+#include <unity.h>
+#include "Sched/ClockSim.h"
+#include "Sched/RateScheduler.h"
+
+/* private macros ------------------------------------------------------------*/
+#define PERIOD_US       10000       // SAMPLE_HZ 100
+#define WORK_US         3000
+#define STEPS           1000
+
+#define EQ_DT           1e-6        // [s] float rounding of the us count
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_no_drift(void)
+{
+    ClockSim clock;
+    RateScheduler sched(clock, PERIOD_US);
+
+    // step time does not add up, the grid is absolute
+    sched.begin();
+    for (uint32_t u32_i = 0; u32_i < STEPS; u32_i++)
+    {
+        TEST_ASSERT_FLOAT_WITHIN(EQ_DT, 1e-6 * PERIOD_US, sched.wait());
+        clock.advance(WORK_US);
+    }
+    TEST_ASSERT_EQUAL_UINT32(STEPS * PERIOD_US + WORK_US, clock.now());
+    TEST_ASSERT_EQUAL_UINT32(0, sched.getOverruns());
+    TEST_ASSERT_EQUAL_UINT32(0, sched.getSkipped());
+}
+
+void test_wrap(void)
+{
+    ClockSim clock(0xFFFFFFFF - 5 * PERIOD_US);
+    RateScheduler sched(clock, PERIOD_US);
+    uint32_t start_us = clock.now();
+
+    // microsecond counter rolls over after 71 minutes
+    sched.begin();
+    for (uint32_t u32_i = 0; u32_i < 10; u32_i++)
+    {
+        TEST_ASSERT_FLOAT_WITHIN(EQ_DT, 1e-6 * PERIOD_US, sched.wait());
+    }
+    TEST_ASSERT_EQUAL_UINT32(start_us + 10 * PERIOD_US, clock.now());
+}
+
+void test_skip(void)
+{
+    ClockSim clock;
+    RateScheduler sched(clock, PERIOD_US, SCHED_SKIP);
+
+    // 2.5 periods late, the two whole slots are gone
+    sched.begin();
+    clock.advance(35000);
+    TEST_ASSERT_FLOAT_WITHIN(EQ_DT, 0.035, sched.wait());
+    TEST_ASSERT_EQUAL_UINT32(35000, clock.now());
+    TEST_ASSERT_EQUAL_UINT32(1, sched.getOverruns());
+    TEST_ASSERT_EQUAL_UINT32(2, sched.getSkipped());
+
+    // back on the original grid
+    TEST_ASSERT_FLOAT_WITHIN(EQ_DT, 0.005, sched.wait());
+    TEST_ASSERT_EQUAL_UINT32(40000, clock.now());
+    sched.wait();
+    TEST_ASSERT_EQUAL_UINT32(50000, clock.now());
+}
+
+void test_catchup(void)
+{
+    ClockSim clock;
+    RateScheduler sched(clock, PERIOD_US, SCHED_CATCHUP);
+
+    // 7.5 periods late, only SCHED_CATCHUP_MAX slots are run again
+    sched.begin();
+    clock.advance(85000);
+    sched.wait();
+    TEST_ASSERT_EQUAL_UINT32(3, sched.getSkipped());
+
+    for (uint32_t u32_i = 0; u32_i < SCHED_CATCHUP_MAX; u32_i++)
+    {
+        TEST_ASSERT_FLOAT_WITHIN(EQ_DT, 0.0, sched.wait());
+        TEST_ASSERT_EQUAL_UINT32(85000, clock.now());
+    }
+    TEST_ASSERT_EQUAL_UINT32(1 + SCHED_CATCHUP_MAX, sched.getOverruns());
+
+    // caught up, sleeps again on the grid
+    TEST_ASSERT_FLOAT_WITHIN(EQ_DT, 0.005, sched.wait());
+    TEST_ASSERT_EQUAL_UINT32(90000, clock.now());
+    TEST_ASSERT_EQUAL_UINT32(3, sched.getSkipped());
+}
+
+void test_resync(void)
+{
+    ClockSim clock;
+    RateScheduler sched(clock, PERIOD_US, SCHED_RESYNC);
+
+    sched.begin();
+    clock.advance(35000);
+    sched.wait();
+    TEST_ASSERT_EQUAL_UINT32(2, sched.getSkipped());
+
+    // new grid starts at the late step
+    TEST_ASSERT_FLOAT_WITHIN(EQ_DT, 0.01, sched.wait());
+    TEST_ASSERT_EQUAL_UINT32(45000, clock.now());
+    sched.wait();
+    TEST_ASSERT_EQUAL_UINT32(55000, clock.now());
+    TEST_ASSERT_EQUAL_UINT32(1, sched.getOverruns());
+}
+
+void test_mark(void)
+{
+    ClockSim clock;
+    RateScheduler sched(clock, PERIOD_US);
+
+    // data ready paced, dt follows the chip and not the period
+    sched.begin();
+    clock.advance(9900);
+    TEST_ASSERT_FLOAT_WITHIN(EQ_DT, 0.0099, sched.mark());
+    clock.advance(10200);
+    TEST_ASSERT_FLOAT_WITHIN(EQ_DT, 0.0102, sched.mark());
+    TEST_ASSERT_FLOAT_WITHIN(EQ_DT, 0.0102, sched.getDt());
+}
+
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_no_drift);
+    RUN_TEST(test_wrap);
+    RUN_TEST(test_skip);
+    RUN_TEST(test_catchup);
+    RUN_TEST(test_resync);
+    RUN_TEST(test_mark);
+    return UNITY_END();
+}
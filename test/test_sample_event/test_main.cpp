@@ -0,0 +1,117 @@
+#include <unity.h>
+#include <thread>
+#include <chrono>
+#include "Sched/SampleEventSim.h"
+
+/* private macros ------------------------------------------------------------*/
+#define PERIOD_US       1000        // 1 kHz data ready, 10x the real rate
+#define SAMPLES         500
+#define WAIT_MS         (2 * (PERIOD_US / 1000) + 1)   // like SensorFUSE
+
+/* private variables ---------------------------------------------------------*/
+static SampleEventSim event;
+
+/* private functions ---------------------------------------------------------*/
+// plays the data ready pin on its own thread
+static void firePin(uint32_t count, uint32_t period_us)
+{
+    auto next = std::chrono::steady_clock::now();
+
+    for (uint32_t u32_i = 0; u32_i < count; u32_i++)
+    {
+        next += std::chrono::microseconds(period_us);
+        std::this_thread::sleep_until(next);
+        event.fire();
+    }
+}
+
+void setUp(void)
+{
+    event.begin();
+}
+
+void tearDown(void)
+{
+}
+
+void test_timeout(void)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    TEST_ASSERT_FALSE(event.wait(5));
+    TEST_ASSERT_TRUE(std::chrono::steady_clock::now() - start >= 
+                     std::chrono::milliseconds(5));
+    TEST_ASSERT_EQUAL_UINT32(0, event.getMissed());
+}
+
+void test_wake(void)
+{
+    std::thread pin(firePin, 1, 2000);
+
+    // sleeps until the edge instead of spinning
+    TEST_ASSERT_TRUE(event.wait(100));
+    pin.join();
+    TEST_ASSERT_EQUAL_UINT32(0, event.getMissed());
+}
+
+void test_missed(void)
+{
+    // three edges before the task got to run, two samples overwritten
+    event.fire();
+    event.fire();
+    event.fire();
+    TEST_ASSERT_TRUE(event.wait(0));
+    TEST_ASSERT_EQUAL_UINT32(2, event.getMissed());
+
+    // pending edges were all taken
+    TEST_ASSERT_FALSE(event.wait(0));
+
+    event.begin();
+    TEST_ASSERT_EQUAL_UINT32(0, event.getMissed());
+}
+
+void test_paced_loop(void)
+{
+    std::thread pin(firePin, SAMPLES, PERIOD_US);
+    uint32_t wakes = 0;
+    uint32_t timeouts = 0;
+
+    // sensor task loop, a slow step shows up as missed, never as lost
+    for (uint32_t u32_i = 0; u32_i < SAMPLES; u32_i++)
+    {
+        if (event.wait(WAIT_MS))
+        {
+            wakes++;
+        }
+        else
+        {
+            timeouts++;
+        }
+        if (0 == (u32_i % 50))
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(3 * PERIOD_US));
+        }
+    }
+    pin.join();
+    while (event.wait(0))
+    {
+        wakes++;
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(SAMPLES, wakes + event.getMissed());
+    TEST_ASSERT_GREATER_THAN_UINT32(0, event.getMissed());
+    TEST_ASSERT_TRUE(timeouts < SAMPLES);
+}
+
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_timeout);
+    RUN_TEST(test_wake);
+    RUN_TEST(test_missed);
+    RUN_TEST(test_paced_loop);
+    return UNITY_END();
+}
@@ -0,0 +1,184 @@
+#include <unity.h>
+#include <thread>
+#include "Sched/SpscRing.h"
+#include "Sched/AttitudeSnapshot.h"
+
+/* private macros ------------------------------------------------------------*/
+#define RING_LEN        32          // SAMPLE_RING
+#define ITEMS           1000000
+#define ITEM_WORDS      15          // 64 byte item, wide enough to tear
+
+/* private typedef -----------------------------------------------------------*/
+typedef struct
+{
+    uint32_t seq;
+    uint32_t fill[ITEM_WORDS];
+} sItem_t;
+
+typedef SpscRing<sItem_t, RING_LEN> ring_t;
+
+/* private variables ---------------------------------------------------------*/
+static ring_t ring;
+
+/* private functions ---------------------------------------------------------*/
+static void fillItem(sItem_t* p_item, uint32_t seq)
+{
+    p_item->seq = seq;
+    for (uint8_t u8_k = 0; u8_k < ITEM_WORDS; u8_k++)
+    {
+        p_item->fill[u8_k] = seq * 2654435761u + u8_k;
+    }
+}
+
+static bool checkItem(const sItem_t* p_item)
+{
+    for (uint8_t u8_k = 0; u8_k < ITEM_WORDS; u8_k++)
+    {
+        if (p_item->fill[u8_k] != p_item->seq * 2654435761u + u8_k)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// sensor task side, never blocks, a full ring drops
+static void produce(uint32_t* p_pushed)
+{
+    sItem_t item;
+
+    *p_pushed = 0;
+    for (uint32_t u32_i = 1; u32_i <= ITEMS; u32_i++)
+    {
+        fillItem(&item, u32_i);
+        *p_pushed += ring.push(item) ? 1 : 0;
+    }
+}
+
+void setUp(void)
+{
+    sItem_t item;
+
+    while (ring.pop(&item))
+    {
+    }
+}
+
+void tearDown(void)
+{
+}
+
+void test_fifo_order(void)
+{
+    sItem_t item;
+    uint32_t pushed;
+    uint32_t popped = 0;
+    uint32_t last = 0;
+    uint32_t torn = 0;
+    uint32_t order = 0;
+    uint32_t dropped = ring.getDropped();
+    std::atomic<bool> done(false);
+    std::thread producer([&] {
+        produce(&pushed);
+        done.store(true, std::memory_order_release);
+    });
+
+    // every item arrives whole, once and in order, gaps are the drops
+    while (1)
+    {
+        if (!ring.pop(&item))
+        {
+            // producer finished, what is left was pushed before
+            if (done.load(std::memory_order_acquire) && (0 == ring.size()))
+            {
+                break;
+            }
+            continue;
+        }
+        popped++;
+        torn += checkItem(&item) ? 0 : 1;
+        order += (item.seq > last) ? 0 : 1;
+        last = item.seq;
+    }
+    producer.join();
+
+    TEST_ASSERT_EQUAL_UINT32(0, torn);
+    TEST_ASSERT_EQUAL_UINT32(0, order);
+    TEST_ASSERT_EQUAL_UINT32(pushed, popped);
+    TEST_ASSERT_EQUAL_UINT32(ITEMS, pushed + ring.getDropped() - dropped);
+}
+
+void test_pop_latest(void)
+{
+    sItem_t item;
+    uint32_t pushed;
+    uint32_t last = 0;
+    uint32_t torn = 0;
+    uint32_t order = 0;
+    std::thread producer(produce, &pushed);
+
+    // report task side, newest only and never older than the last one
+    for (uint32_t u32_i = 0; u32_i < ITEMS / 10; u32_i++)
+    {
+        if (ring.popLatest(&item))
+        {
+            torn += checkItem(&item) ? 0 : 1;
+            order += (item.seq > last) ? 0 : 1;
+            last = item.seq;
+        }
+    }
+    producer.join();
+
+    TEST_ASSERT_EQUAL_UINT32(0, torn);
+    TEST_ASSERT_EQUAL_UINT32(0, order);
+    TEST_ASSERT_TRUE(ring.popLatest(&item) || (ITEMS == last));
+}
+
+void test_snapshot(void)
+{
+    static AttitudeSnapshot snapshot;
+    sAttitude_t sample;
+    uint32_t torn = 0;
+    uint32_t reads = 0;
+    std::thread writer([] {
+        sAttitude_t out;
+
+        for (uint32_t u32_i = 1; u32_i <= ITEMS; u32_i++)
+        {
+            out.t_us = u32_i;
+            out.marg.accl.x = out.marg.gyro.z = out.marg.magn.y = u32_i;
+            out.quat.w = out.quat.z = u32_i;
+            snapshot.publish(&out);
+        }
+    });
+
+    // readers from other tasks always see one whole sample
+    while (reads < ITEMS / 10)
+    {
+        if (!snapshot.read(&sample))
+        {
+            continue;
+        }
+        reads++;
+        torn += ((float)sample.t_us != sample.marg.accl.x) || 
+                (sample.marg.accl.x != sample.marg.gyro.z) ||
+                (sample.marg.gyro.z != sample.marg.magn.y) ||
+                (sample.marg.magn.y != sample.quat.w) ||
+                (sample.quat.w != sample.quat.z);
+    }
+    writer.join();
+
+    TEST_ASSERT_EQUAL_UINT32(0, torn);
+}
+
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_fifo_order);
+    RUN_TEST(test_pop_latest);
+    RUN_TEST(test_snapshot);
+    return UNITY_END();
+}